@@ -0,0 +1,261 @@
+#include "big_fixed.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using u128 = unsigned __int128;
+
+// r[0, rn) += a[0, an) with an <= rn, returns the carry out of the top limb
+static uint64_t addLimbs(uint64_t *r, int rn, const uint64_t *a, int an)
+{
+    uint64_t carry = 0;
+    for (int i = 0; i < rn && (i < an || carry); ++i)
+    {
+        u128 t = static_cast<u128>(r[i]) + (i < an ? a[i] : 0) + carry;
+        r[i] = static_cast<uint64_t>(t);
+        carry = static_cast<uint64_t>(t >> 64);
+    }
+    return carry;
+}
+
+// r[0, rn) -= a[0, an) with an <= rn, returns the borrow out of the top limb
+static uint64_t subLimbs(uint64_t *r, int rn, const uint64_t *a, int an)
+{
+    uint64_t borrow = 0;
+    for (int i = 0; i < rn && (i < an || borrow); ++i)
+    {
+        uint64_t s = i < an ? a[i] : 0;
+        uint64_t d = r[i] - s - borrow;
+        borrow = (r[i] < s || (r[i] == s && borrow)) ? 1 : 0;
+        r[i] = d;
+    }
+    return borrow;
+}
+
+static void multiplySchoolbook(const uint64_t *a, const uint64_t *b, int n, uint64_t *out)
+{
+    std::fill(out, out + 2 * n, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        uint64_t carry = 0;
+        for (int j = 0; j < n; ++j)
+        {
+            u128 t = static_cast<u128>(a[i]) * b[j] + out[i + j] + carry;
+            out[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+        out[i + n] = carry;
+    }
+}
+
+// Scratch limbs used by karatsuba() for n limbs, its recursion included
+static int karatsubaScratch(int n)
+{
+    if (n < BigFixed::KARATSUBA_LIMBS)
+        return 0;
+    int k = n - n / 2;
+    return 4 * (k + 1) + karatsubaScratch(k + 1);
+}
+
+static void karatsuba(const uint64_t *a, const uint64_t *b, int n, uint64_t *out, uint64_t *scratch)
+{
+    if (n < BigFixed::KARATSUBA_LIMBS)
+    {
+        multiplySchoolbook(a, b, n, out);
+        return;
+    }
+
+    // a = a1 * 2^(64h) + a0, same for b, then
+    // a * b = z2 * 2^(128h) + (z1 - z2 - z0) * 2^(64h) + z0 with
+    // z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) * (b0 + b1)
+    const int h = n / 2;
+    const int k = n - h;
+    uint64_t *sa = scratch;
+    uint64_t *sb = sa + (k + 1);
+    uint64_t *mid = sb + (k + 1);
+    uint64_t *rest = mid + 2 * (k + 1);
+
+    std::copy(a + h, a + n, sa);
+    std::copy(b + h, b + n, sb);
+    sa[k] = sb[k] = 0;
+    addLimbs(sa, k + 1, a, h);
+    addLimbs(sb, k + 1, b, h);
+    karatsuba(sa, sb, k + 1, mid, rest);
+
+    karatsuba(a, b, h, out, rest);
+    karatsuba(a + h, b + h, k, out + 2 * h, rest);
+
+    subLimbs(mid, 2 * (k + 1), out, 2 * h);
+    subLimbs(mid, 2 * (k + 1), out + 2 * h, 2 * k);
+
+    // The middle term is below 2^(64n + 1), so it fits the top of out
+    addLimbs(out + h, 2 * n - h, mid, std::min(2 * (k + 1), 2 * n - h));
+}
+
+void BigFixed::multiply(const uint64_t *a, const uint64_t *b, int n, uint64_t *out)
+{
+    if (n < KARATSUBA_LIMBS)
+    {
+        multiplySchoolbook(a, b, n, out);
+        return;
+    }
+
+    std::vector<uint64_t> scratch(karatsubaScratch(n));
+    karatsuba(a, b, n, out, scratch.data());
+}
+
+// 53-bit integer mantissa of a FloatExp mantissa: |m| = mantissa * 2^-53
+static uint64_t integerMantissa(double m)
+{
+    return static_cast<uint64_t>(std::ldexp(std::abs(m), 53));
+}
+
+// Fraction limbs holding mantissa * 2^(e - 53) exactly
+static int exactFractionLimbs(uint64_t mantissa, int64_t e)
+{
+    if (mantissa == 0)
+        return 0;
+    // Lowest set bit at 2^lsb
+    int64_t lsb = e - 53 + std::countr_zero(mantissa);
+    if (lsb >= 0)
+        return 0;
+    return static_cast<int>(std::min<int64_t>((-lsb + 63) / 64, BigFixed::MAX_FRACTION_LIMBS));
+}
+
+BigFixed::BigFixed(double x) : BigFixed(FloatExp(x))
+{
+}
+
+BigFixed::BigFixed(double x, int fractionLimbs) : limbs(fractionLimbs + 1, 0)
+{
+    FloatExp value(x);
+    assign(integerMantissa(value.m), value.e - 53, x < 0.0);
+}
+
+BigFixed::BigFixed(const FloatExp &x)
+    : limbs(exactFractionLimbs(integerMantissa(x.m), x.e) + 1, 0)
+{
+    assign(integerMantissa(x.m), x.e - 53, x.m < 0.0);
+}
+
+void BigFixed::assign(uint64_t mantissa, int64_t exponent, bool negative)
+{
+    if (mantissa == 0)
+        return;
+
+    // The fixed-point integer is mantissa * 2^shift
+    const int fractionLimbs = getFractionLimbs();
+    int64_t shift = exponent + 64 * fractionLimbs;
+    if (shift < 0)
+    {
+        mantissa = shift > -64 ? mantissa >> -shift : 0;
+        shift = 0;
+    }
+
+    int index = static_cast<int>(shift / 64);
+    int offset = static_cast<int>(shift % 64);
+    limbs[index] = mantissa << offset;
+    if (offset != 0 && index < fractionLimbs)
+        limbs[index + 1] = mantissa >> (64 - offset);
+
+    if (negative)
+        negate();
+}
+
+int BigFixed::limbsForDiam(const FloatExp &diam)
+{
+    int bits = static_cast<int>(std::ceil(-diam.log2())) + GUARD_BITS;
+    return std::clamp((bits + 63) / 64, 1, MAX_FRACTION_LIMBS);
+}
+
+BigFixed BigFixed::withPrecision(int fractionLimbs) const
+{
+    BigFixed result(0.0, fractionLimbs);
+    int shift = fractionLimbs - getFractionLimbs();
+    if (shift >= 0)
+        std::copy(limbs.begin(), limbs.end(), result.limbs.begin() + shift);
+    else
+        std::copy(limbs.begin() - shift, limbs.end(), result.limbs.begin());
+    return result;
+}
+
+void BigFixed::negate()
+{
+    uint64_t carry = 1;
+    for (uint64_t &limb : limbs)
+    {
+        limb = ~limb + carry;
+        carry = (carry && limb == 0) ? 1 : 0;
+    }
+}
+
+double BigFixed::toDouble() const
+{
+    BigFixed magnitude = isNegative() ? -*this : *this;
+    const int n = getFractionLimbs();
+    double result = 0.0;
+    for (int i = 0; i <= n; ++i)
+        result += std::ldexp(static_cast<double>(magnitude.limbs[i]), 64 * (i - n));
+    return isNegative() ? -result : result;
+}
+
+FloatExp BigFixed::toFloatExp() const
+{
+    BigFixed magnitude = isNegative() ? -*this : *this;
+    const int n = getFractionLimbs();
+    int top = n;
+    while (top > 0 && magnitude.limbs[top] == 0)
+        --top;
+
+    // The two leading limbs hold more than the 53 bits of the mantissa
+    double m = static_cast<double>(magnitude.limbs[top]);
+    if (top > 0)
+        m += std::ldexp(static_cast<double>(magnitude.limbs[top - 1]), -64);
+    FloatExp result = FloatExp::normalize(m, 64 * int64_t(top - n));
+    return isNegative() ? -result : result;
+}
+
+DoubleDouble BigFixed::toDoubleDouble() const
+{
+    double hi = toDouble();
+    return {hi, (*this - BigFixed(hi)).toDouble()};
+}
+
+BigFixed operator-(const BigFixed &a)
+{
+    BigFixed result = a;
+    result.negate();
+    return result;
+}
+
+BigFixed operator+(const BigFixed &a, const BigFixed &b)
+{
+    const int n = std::max(a.getFractionLimbs(), b.getFractionLimbs());
+    BigFixed result = a.withPrecision(n);
+    BigFixed other = b.withPrecision(n);
+    // Two's complement: the carry out of the integer limb is dropped
+    addLimbs(result.limbs.data(), n + 1, other.limbs.data(), n + 1);
+    return result;
+}
+
+BigFixed operator-(const BigFixed &a, const BigFixed &b)
+{
+    return a + -b;
+}
+
+BigFixed operator*(const BigFixed &a, const BigFixed &b)
+{
+    const int n = std::max(a.getFractionLimbs(), b.getFractionLimbs());
+    const bool negative = a.isNegative() != b.isNegative();
+
+    // Multiply magnitudes, then drop the n extra fraction limbs of the product
+    BigFixed x = (a.isNegative() ? -a : a).withPrecision(n);
+    BigFixed y = (b.isNegative() ? -b : b).withPrecision(n);
+    std::vector<uint64_t> product(2 * (n + 1));
+    BigFixed::multiply(x.limbs.data(), y.limbs.data(), n + 1, product.data());
+
+    std::copy(product.begin() + n, product.begin() + 2 * n + 1, x.limbs.begin());
+    if (negative)
+        x.negate();
+    return x;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "double_double.h"
+#include "float_exp.h"
+#include <cstdint>
+#include <vector>
+
+// Signed fixed-point number of arbitrary precision: a two's complement integer over
+// 64-bit limbs, least significant first, scaled by 2^(-64 * fraction limbs). The top
+// limb holds the integer part. Self-contained (no GMP/MPFR): products go through
+// unsigned __int128, and switch to Karatsuba once operands reach KARATSUBA_LIMBS.
+// Precision is per value and grows as needed: a double converts exactly, and sums
+// and products take the precision of their most precise operand.
+class BigFixed
+{
+public:
+    // Smallest view diameter the coordinates resolve, 2^-3322 (about 1e-1000)
+    static constexpr int MIN_DIAM_EXPONENT = -3322;
+    // Extra bits kept below the size of the smallest feature of a view
+    static constexpr int GUARD_BITS = 64;
+    // Enough for the smallest diameter, and more than the 17 fraction limbs
+    // holding every double exactly
+    static constexpr int MAX_FRACTION_LIMBS = (-MIN_DIAM_EXPONENT + GUARD_BITS + 63) / 64;
+    // Operand size (in limbs) from which multiplication uses Karatsuba. Measured
+    // crossover: below it the __int128 schoolbook loop wins (by 20% at 24 limbs),
+    // at 54 limbs one split is on par or up to 10% faster. Orbits of views below
+    // about 1e-867 reach it.
+    static constexpr int KARATSUBA_LIMBS = 48;
+
+    // Exact conversion, with as many fraction limbs as the value needs
+    BigFixed(double x = 0.0);
+    // Conversion truncated to the given number of fraction limbs
+    BigFixed(double x, int fractionLimbs);
+    // Exact conversion of a value beyond the double range, up to MAX_FRACTION_LIMBS
+    explicit BigFixed(const FloatExp &x);
+
+    // Fraction limbs needed to resolve features of size diam with a safety margin
+    static int limbsForDiam(const FloatExp &diam);
+
+    int getFractionLimbs() const { return static_cast<int>(limbs.size()) - 1; }
+    // Same value, extended with zero limbs or truncated
+    BigFixed withPrecision(int fractionLimbs) const;
+
+    bool isNegative() const { return static_cast<int64_t>(limbs.back()) < 0; }
+    double toDouble() const;
+    // Same with the exponent range of FloatExp, for offsets below 1e-308
+    FloatExp toFloatExp() const;
+    DoubleDouble toDoubleDouble() const;
+
+    friend BigFixed operator-(const BigFixed &a);
+    friend BigFixed operator+(const BigFixed &a, const BigFixed &b);
+    friend BigFixed operator-(const BigFixed &a, const BigFixed &b);
+    friend BigFixed operator*(const BigFixed &a, const BigFixed &b);
+
+    // out[0, 2n) = a[0, n) * b[0, n), unsigned
+    static void multiply(const uint64_t *a, const uint64_t *b, int n, uint64_t *out);
+
+private:
+    std::vector<uint64_t> limbs;
+
+    // Sets the magnitude mantissa * 2^exponent, truncated to the limbs there are
+    void assign(uint64_t mantissa, int64_t exponent, bool negative);
+    void negate();
+};
+
+inline BigFixed &operator+=(BigFixed &a, const BigFixed &b)
+{
+    return a = a + b;
+}
+
+inline BigFixed &operator-=(BigFixed &a, const BigFixed &b)
+{
+    return a = a - b;
+}
+
+inline BigFixed &operator*=(BigFixed &a, const BigFixed &b)
+{
+    return a = a * b;
+}
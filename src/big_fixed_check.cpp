@@ -0,0 +1,63 @@
+// Checks BigFixed::multiply against a plain schoolbook product for every operand
+// size a view can use, Karatsuba sizes included. Run with make check.
+#include "big_fixed.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static_assert(BigFixed::MAX_FRACTION_LIMBS + 1 >= BigFixed::KARATSUBA_LIMBS,
+              "the deepest views must reach Karatsuba");
+
+// out[0, 2n) = a[0, n) * b[0, n), one limb product at a time
+static void referenceProduct(const uint64_t *a, const uint64_t *b, int n, uint64_t *out)
+{
+    using u128 = unsigned __int128;
+    std::fill(out, out + 2 * n, 0);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+        {
+            u128 t = static_cast<u128>(a[i]) * b[j];
+            for (int k = i + j; t != 0; ++k)
+            {
+                t += out[k];
+                out[k] = static_cast<uint64_t>(t);
+                t >>= 64;
+            }
+        }
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    int failures = 0;
+    int karatsubaSizes = 0;
+
+    for (int n = 1; n <= BigFixed::MAX_FRACTION_LIMBS + 1; ++n)
+    {
+        std::vector<uint64_t> a(n), b(n), product(2 * n), expected(2 * n);
+
+        // Random limbs, then all ones for the longest carry chains
+        for (int pattern = 0; pattern < 2; ++pattern)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                a[i] = pattern == 0 ? random() : ~uint64_t(0);
+                b[i] = pattern == 0 ? random() : ~uint64_t(0);
+            }
+
+            BigFixed::multiply(a.data(), b.data(), n, product.data());
+            referenceProduct(a.data(), b.data(), n, expected.data());
+            if (product != expected)
+            {
+                std::printf("multiply: wrong product for %d limbs (pattern %d)\n", n, pattern);
+                ++failures;
+            }
+        }
+        if (n >= BigFixed::KARATSUBA_LIMBS)
+            ++karatsubaSizes;
+    }
+
+    std::printf("multiply: %d sizes checked, %d through Karatsuba, %d failures\n",
+                BigFixed::MAX_FRACTION_LIMBS + 1, karatsubaSizes, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// One bit per pixel, packed in 64-bit words: the per-pixel flags of a poster-size
+// render cost an eighth of a byte each instead of a byte
+class BitPlane
+{
+public:
+    void resize(size_t count) { words.assign((count + 63) / 64, 0); }
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+
+    bool test(size_t p) const { return (words[p >> 6] >> (p & 63)) & 1; }
+    void set(size_t p) { words[p >> 6] |= uint64_t(1) << (p & 63); }
+
+    // Sets the bit, returns whether it was already set
+    bool testAndSet(size_t p)
+    {
+        uint64_t bit = uint64_t(1) << (p & 63);
+        bool was = words[p >> 6] & bit;
+        words[p >> 6] |= bit;
+        return was;
+    }
+
+    // Sets the bits of [begin, end) and calls newlySet(p) for each one that was
+    // clear. Whole words are tested at once, so runs already set cost next to nothing.
+    template <typename F>
+    void setRange(size_t begin, size_t end, F &&newlySet)
+    {
+        while (begin < end)
+        {
+            const size_t word = begin >> 6;
+            const size_t last = std::min(end, (word + 1) << 6);
+            uint64_t mask = ~uint64_t(0) << (begin & 63);
+            if (last & 63)
+                mask &= ~(~uint64_t(0) << (last & 63));
+            for (uint64_t fresh = mask & ~words[word]; fresh; fresh &= fresh - 1)
+                newlySet((word << 6) + std::countr_zero(fresh));
+            words[word] |= mask;
+            begin = last;
+        }
+    }
+
+private:
+    std::vector<uint64_t> words;
+};
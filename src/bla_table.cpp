@@ -0,0 +1,74 @@
+#include "bla_table.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Relative size of the dropped dz^2 term: below double rounding the linear step is exact
+constexpr double BLA_EPSILON = 0x1p-53;
+} // namespace
+
+template <class Real>
+void BlaTable<Real>::compute(const ReferenceOrbit &orbit, Real dcMax)
+{
+    using std::hypot;
+    using std::sqrt;
+
+    levels.clear();
+
+    // Steps may run up to the last orbit point, pixels check for escape there
+    const int last = orbit.size() - 1;
+    if (last < 1)
+        return;
+
+    // Level 0: single iteration dz -> 2 Z dz + dc, dropping dz^2
+    std::vector<BlaStep<Real>> level(last);
+    for (int m = 0; m < last; ++m)
+    {
+        Real ar = 2.0 * orbit.getR(m);
+        Real ai = 2.0 * orbit.getI(m);
+        Real radius = Real(BLA_EPSILON) * hypot(ar, ai);
+        level[m] = {ar, ai, Real(1.0), Real(0.0), radius * radius};
+    }
+    levels.push_back(std::move(level));
+
+    // Level l + 1 merges consecutive steps x then y of level l:
+    // A = Ay Ax, B = Ay Bx + By, r = min(rx, (ry - |Bx| dcMax) / |Ax|)
+    while (levels.back().size() >= 2)
+    {
+        const std::vector<BlaStep<Real>> &below = levels.back();
+        std::vector<BlaStep<Real>> merged(below.size() / 2);
+        for (size_t j = 0; j < merged.size(); ++j)
+        {
+            const BlaStep<Real> &x = below[2 * j];
+            const BlaStep<Real> &y = below[2 * j + 1];
+            BlaStep<Real> &step = merged[j];
+
+            step.ar = y.ar * x.ar - y.ai * x.ai;
+            step.ai = y.ar * x.ai + y.ai * x.ar;
+            step.br = y.ar * x.br - y.ai * x.bi + y.br;
+            step.bi = y.ar * x.bi + y.ai * x.br + y.bi;
+
+            Real rx = sqrt(x.radius2);
+            Real ry = sqrt(y.radius2);
+            Real ax = hypot(x.ar, x.ai);
+            Real radius = ax > Real(0.0) ? std::max(Real(0.0), (ry - hypot(x.br, x.bi) * dcMax) / ax) : rx;
+            radius = std::min(rx, radius);
+            step.radius2 = radius * radius;
+        }
+        levels.push_back(std::move(merged));
+    }
+
+    // Drop the levels that never apply (all of them on shallow views, where dcMax
+    // exceeds every radius) so lookups stop early
+    auto unused = [](const std::vector<BlaStep<Real>> &steps)
+    {
+        return std::all_of(steps.begin(), steps.end(), [](const BlaStep<Real> &step)
+                           { return !(Real(0.0) < step.radius2); });
+    };
+    while (levels.size() > 1 && unused(levels.back()))
+        levels.pop_back();
+}
+
+template class BlaTable<double>;
+template class BlaTable<FloatExp>;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "reference_orbit.h"
+#include "float_exp.h"
+#include <vector>
+
+// One bivariate linear approximation: starting at orbit index m, 2^level iterations
+// of the perturbed formula collapse into dz -> A dz + B dc, valid while |dz| < radius
+template <class Real>
+struct BlaStep
+{
+    Real ar, ai;
+    Real br, bi;
+    Real radius2; // Squared validity radius
+};
+
+// Bivariate linear approximation table: a hierarchy of BLA steps built from the
+// reference orbit. Level l holds the steps covering 2^l iterations that start at
+// multiples of 2^l, built by merging pairs of the level below, so a pixel can jump
+// over long runs of iterations with O(log n) lookups. A merged step is never valid
+// further than the first step it contains.
+// The radii depend on the largest pixel offset, so one table serves one view.
+// Real is double, or FloatExp for views deeper than the double range, whose radii
+// and B coefficients leave it.
+template <class Real>
+class BlaTable
+{
+public:
+    // dcMax is the largest pixel offset from the reference point
+    void compute(const ReferenceOrbit &orbit, Real dcMax);
+
+    // Longest step valid at orbit index m for a delta of squared size dz2, covering
+    // at most maxIters iterations, or nullptr. Sets length to the iterations it covers.
+    // Inline: called on every iteration of the pixel loop.
+    const BlaStep<Real> *lookup(int m, Real dz2, int maxIters, int &length) const
+    {
+        // Steps of level l start at multiples of 2^l. Level 0 saves nothing over a
+        // regular iteration, so the search starts at level 1, and since merging only
+        // shrinks the radius it climbs while the next level is still valid.
+        const BlaStep<Real> *found = nullptr;
+        for (size_t l = 1; l < levels.size(); ++l)
+        {
+            int steps = 1 << l;
+            size_t j = m >> l;
+            if ((m & (steps - 1)) != 0 || steps > maxIters || j >= levels[l].size())
+                break;
+            const BlaStep<Real> &step = levels[l][j];
+            if (!(dz2 < step.radius2))
+                break;
+            found = &step;
+            length = steps;
+        }
+        return found;
+    }
+
+private:
+    std::vector<std::vector<BlaStep<Real>>> levels;
+};
@@ -1,65 +1,116 @@
 #include "border_mandelbrot_calculator.h"
+#include "interior_fill.h"
 #include <cmath>
 #include <algorithm>
 
 BorderMandelbrotCalculator::BorderMandelbrotCalculator(int w, int h)
-    : StorageMandelbrotCalculator(w, h), queueHead(0), queueTail(0)
+    : StorageMandelbrotCalculator(w, h), periodEps(0.0), derivativeEps(0.0), kernels(selectSimdKernels()), queueHead(0), queueTail(0)
 {
-    done.resize(width * height, 0);
-    // Resize to max possible pixels + 1 to prevent ring buffer overflow
-    queue.resize(width * height + 1);
+    loaded.resize(width * height);
+    queued.resize(width * height);
+    queue.resize((width + height) * 4);
 }
 
 void BorderMandelbrotCalculator::reset()
 {
     StorageMandelbrotCalculator::reset();
-    std::fill(done.begin(), done.end(), 0);
+    loaded.clear();
+    queued.clear();
     queueHead = queueTail = 0;
 }
 
-int BorderMandelbrotCalculator::iterate(double x, double y)
+void BorderMandelbrotCalculator::iteratePixels(const unsigned *pixels, unsigned count)
 {
-    double r = x, i = y;
-    int iter;
-
-    for (iter = 0; iter < MAX_ITER; ++iter)
-    {
-        double r2 = r * r;
-        double i2 = i * i;
-
-        if (r2 + i2 >= 4.0)
-            break;
-
-        double ri = r * i;
-        i = ri + ri + y; // z = z^2 + c
-        r = r2 - i2 + x;
-    }
+    // Double kernel only: the tracing compares neighbor values, it stays exact
+    // where the SIMD engine switches to float
+    const SimdView view = {minr, mini, stepr, stepi, width, periodEps, derivativeEps, maxIter};
+    kernels.f64List(view, pixels, count, data.data());
+}
 
-    return iter;
+void BorderMandelbrotCalculator::growQueue()
+{
+    // Unroll the ring into a buffer twice as large, oldest entry first
+    std::vector<unsigned> grown(queue.size() * 2);
+    unsigned count = 0;
+    for (unsigned i = queueTail; i != queueHead; i = (i + 1 == queue.size()) ? 0 : i + 1)
+        grown[count++] = queue[i];
+    queue.swap(grown);
+    queueTail = 0;
+    queueHead = count;
 }
 
 void BorderMandelbrotCalculator::addQueue(unsigned p)
 {
-    if (done[p] & QUEUED)
+    if (queued.testAndSet(p))
         return;
-    done[p] |= QUEUED;
+    // One slot stays free to tell a full ring from an empty one
+    unsigned next = (queueHead + 1 == queue.size()) ? 0 : queueHead + 1;
+    if (next == queueTail)
+        growQueue();
     queue[queueHead++] = p;
     if (queueHead == queue.size())
         queueHead = 0;
 }
 
-int BorderMandelbrotCalculator::load(unsigned p)
+bool BorderMandelbrotCalculator::dequeue(unsigned &p, unsigned &flag)
 {
-    if (done[p] & LOADED)
-        return data[p];
+    if (queueTail == queueHead)
+        return false;
+
+    // Mixed FIFO/LIFO for better visual effect
+    if (queueHead <= queueTail || ++flag & 3)
+    {
+        // FIFO: dequeue from tail
+        p = queue[queueTail++];
+        if (queueTail == queue.size())
+            queueTail = 0;
+    }
+    else
+    {
+        // LIFO: dequeue from head
+        if (queueHead == 0)
+            queueHead = queue.size();
+        p = queue[--queueHead];
+    }
+    return true;
+}
+
+void BorderMandelbrotCalculator::request(unsigned p)
+{
+    // Flagged as loaded right away: nothing reads data before the whole batch is in
+    if (loaded.testAndSet(p))
+        return;
+    pending.push_back(p);
+}
 
-    unsigned x = p % width;
-    unsigned y = p / width;
+void BorderMandelbrotCalculator::loadBatch(const unsigned *batch, int count)
+{
+    // Every pixel scan() reads: the dequeued ones and their 4 neighbors
+    pending.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        unsigned p = batch[i];
+        int x = p % width;
+        int y = p / width;
+        request(p);
+        if (x >= 1)
+            request(p - 1);
+        if (x < width - 1)
+            request(p + 1);
+        if (y >= 1)
+            request(p - width);
+        if (y < height - 1)
+            request(p + width);
+    }
 
-    int result = iterate(minr + x * stepr, mini + y * stepi);
+    iteratePixels(pending.data(), pending.size());
+}
 
-    done[p] |= LOADED;
-    return data[p] = result;
+int BorderMandelbrotCalculator::load(unsigned p)
+{
+    if (!loaded.test(p))
+        loadBatch(&p, 1);
+    return data[p];
 }
 
 void BorderMandelbrotCalculator::scan(unsigned p)
@@ -102,8 +153,12 @@ void BorderMandelbrotCalculator::scan(unsigned p)
 
 void BorderMandelbrotCalculator::compute(std::function<void()> progressCallback)
 {
-    // Start high-precision timer
     data.assign(width * height, 0);
+    loaded.clear();
+    queued.clear();
+    queueHead = queueTail = 0;
+    periodEps = periodicityEpsilon();
+    derivativeEps = derivativeEpsilon();
 
     // First Pass: Border Tracing
 
@@ -119,49 +174,33 @@ void BorderMandelbrotCalculator::compute(std::function<void()> progressCallback)
         addQueue((height - 1) * width + x);
     }
 
-    // Process the queue (mixed FIFO/LIFO for better visual effect)
+    // Process the queue a batch at a time: the pixels the batch will read are loaded
+    // together through the vector kernel, then scanned. Scans only add pixels to the
+    // queue, so the traced set is the same as one pixel at a time.
     unsigned processed = 0;
+    unsigned reported = 0;
     unsigned flag = 0;
+    unsigned batch[BATCH_SIZE];
     while (queueTail != queueHead)
     {
-        unsigned p;
-        if (queueHead <= queueTail || ++flag & 3)
-        {
-            // FIFO: dequeue from tail
-            p = queue[queueTail++];
-            if (queueTail == queue.size())
-                queueTail = 0;
-        }
-        else
-        {
-            // LIFO: dequeue from head
-            if (queueHead == 0)
-                queueHead = queue.size();
-            p = queue[--queueHead];
-        }
+        int count = 0;
+        while (count < BATCH_SIZE && dequeue(batch[count], flag))
+            ++count;
 
-        scan(p);
+        loadBatch(batch, count);
+        for (int i = 0; i < count; ++i)
+            scan(batch[i]);
 
         // Update display periodically (skip in speed mode)
-        ++processed;
-        if (!speedMode && processed % 1000 == 0)
+        processed += count;
+        if (!speedMode && processed - reported >= 1000)
         {
+            reported = processed;
             if (progressCallback)
                 progressCallback();
         }
     }
 
     // Fill uncalculated areas with neighbor color
-    for (int p = 0; p < width * height - 1; ++p)
-    {
-        if (done[p] & LOADED)
-        {
-            if (!(done[p + 1] & LOADED))
-            {
-                data[p + 1] = data[p];
-                done[p + 1] |= LOADED;
-            }
-        }
-    }
-
+    fillUntracedPixels(data.data(), width, height, [this](unsigned p) { return loaded.test(p); });
 }
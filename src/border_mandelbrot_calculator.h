@@ -1,6 +1,8 @@
 #pragma once
 
 #include "storage_mandelbrot_calculator.h"
+#include "simd_kernels.h"
+#include "bit_plane.h"
 #include <vector>
 #include <functional>
 
@@ -15,19 +17,37 @@ public:
     
     std::string getEngineName() const override { return "border"; }
 
+protected:
+    // Evaluates pixels[0, count) (indices into data) and stores their iteration
+    // counts. Called once per pixel the tracing visits, with the pixels of a batch.
+    virtual void iteratePixels(const unsigned *pixels, unsigned count);
+
+    // Periodicity check distance of the current compute, 0 when disabled
+    double periodEps;
+    // Derivative interior threshold of the current compute, 0 when disabled
+    double derivativeEps;
+
 private:
-    std::vector<unsigned char> done;
+    // Queued pixels scanned together: the pixels they read are loaded in one call
+    static constexpr int BATCH_SIZE = 32;
+
+    const SimdKernels &kernels;
+    // Pixel flags, one bit plane each
+    BitPlane loaded; // Value in data, or collected for the batch being loaded
+    BitPlane queued; // Added to the queue once, never again
+    // Ring buffer of the frontier. Starts at the perimeter-sized queue of the
+    // reference implementation ((width + height) * 4) and doubles when full, so it
+    // follows the active boundary instead of the pixel count.
     std::vector<unsigned> queue;
     unsigned queueHead, queueTail;
+    // Pixels collected by loadBatch, kept to reuse the allocation
+    std::vector<unsigned> pending;
 
-    enum Flags
-    {
-        LOADED = 1,
-        QUEUED = 2
-    };
-
-    int iterate(double x, double y);
+    void growQueue();
     void addQueue(unsigned p);
+    bool dequeue(unsigned &p, unsigned &flag);
+    void request(unsigned p);
+    void loadBatch(const unsigned *batch, int count);
     int load(unsigned p);
     void scan(unsigned p);
 };
@@ -0,0 +1,172 @@
+#include "distance_estimator_mandelbrot_calculator.h"
+#include "interior_check.h"
+#include <algorithm>
+#include <cmath>
+
+DistanceEstimatorMandelbrotCalculator::DistanceEstimatorMandelbrotCalculator(int w, int h)
+    : StorageMandelbrotCalculator(w, h), pixel(0)
+{
+    known.resize(width * height);
+}
+
+int DistanceEstimatorMandelbrotCalculator::exteriorValue(double distance) const
+{
+    // Logarithmic: the shades go to the last few pixels around the boundary
+    int level = int(DE_LEVELS * std::log2(1 + distance) / std::log2(1 + SATURATION_PIXELS));
+    return std::min(level, DE_LEVELS) * (maxIter - 1) / DE_LEVELS;
+}
+
+double DistanceEstimatorMandelbrotCalculator::interiorDistance(const Complex &c, Complex z, int period) const
+{
+    // Newton's method on F^p(w) = w pins down the cycle point
+    for (int i = 0; i < 16; ++i)
+    {
+        Complex f = z, df = 1;
+        for (int k = 0; k < period; ++k)
+        {
+            df = 2.0 * f * df;
+            f = f * f + c;
+        }
+        Complex delta = (f - z) / (df - 1.0);
+        z -= delta;
+        if (std::norm(delta) < 1e-30)
+            break;
+    }
+
+    // Derivatives over one period at the cycle point: dz = dF/dz, dc = dF/dc and the
+    // second derivatives dzdz and dcdz, each update from the previous values
+    Complex dz = 1, dc = 0, dzdz = 0, dcdz = 0;
+    for (int k = 0; k < period; ++k)
+    {
+        dcdz = 2.0 * (z * dcdz + dc * dz);
+        dzdz = 2.0 * (z * dzdz + dz * dz);
+        dc = 2.0 * z * dc + 1.0;
+        dz = 2.0 * z * dz;
+        z = z * z + c;
+    }
+    if (std::norm(dz) >= 1)
+        return 0;
+
+    double distance = (1 - std::norm(dz)) / std::abs(dcdz + dzdz * dc / (1.0 - dz));
+    return std::isfinite(distance) ? distance : 0;
+}
+
+int DistanceEstimatorMandelbrotCalculator::evaluate(const Complex &c, double &fillRadius) const
+{
+    fillRadius = 0;
+
+    // Main cardioid and period-2 bulb: their cycle is known in closed form
+    if (isInMainCardioidOrBulb(c.real(), c.imag()))
+    {
+        Complex fixed = (1.0 - std::sqrt(1.0 - 4.0 * c)) / 2.0;
+        bool cardioid = std::norm(2.0 * fixed) < 1;
+        Complex start = cardioid ? fixed : (-1.0 + std::sqrt(-3.0 - 4.0 * c)) / 2.0;
+        fillRadius = interiorDistance(c, start, cardioid ? 1 : 2) / 4 / pixel;
+        return maxIter;
+    }
+
+    double zr = 0, zi = 0;
+    double dr = 0, di = 0; // dz/dc
+    // Brent cycle detection against a point saved at power-of-two iterations: an
+    // orbit that comes back this close may have settled on an attracting cycle,
+    // whose period the interior estimate needs. Orbits near the boundary also
+    // linger by repelling cycles and escape later, so a cycle only counts once
+    // the estimate finds it attracting.
+    double sr = 0, si = 0;
+    int saveAt = 1;
+    bool checking = true; // Cleared by a repelling cycle until the next saved point
+    for (int iter = 0;; ++iter)
+    {
+        double zr2 = zr * zr;
+        double zi2 = zi * zi;
+        // Past |z| = 2 the point escapes for sure: it gets the few iterations up to
+        // the large radius even when they overrun the budget
+        if (iter >= maxIter && zr2 + zi2 <= 4)
+            break;
+        if (zr2 + zi2 > ESCAPE_RADIUS2)
+        {
+            // Exterior estimate 2 |z| log|z| / |dz/dc|, within a factor 4 of the distance
+            double norm = zr2 + zi2;
+            double distance = std::sqrt(norm / (dr * dr + di * di)) * std::log(norm);
+            // A pixel in the disk is at least distance / 4 - r from the set: past the
+            // saturation distance it gets the saturated shade whatever its estimate
+            fillRadius = std::max(0.0, distance / 4 / pixel - SATURATION_PIXELS);
+            return exteriorValue(distance / pixel);
+        }
+
+        // dz/dc <- 2 z dz/dc + 1, then z <- z^2 + c
+        double ndr = 2 * (zr * dr - zi * di) + 1;
+        double ndi = 2 * (zr * di + zi * dr);
+        dr = ndr;
+        di = ndi;
+        zi = 2 * zr * zi + c.imag();
+        zr = zr2 - zi2 + c.real();
+
+        double er = zr - sr, ei = zi - si;
+        if (checking && er * er + ei * ei < CYCLE_DISTANCE2)
+        {
+            double interior = interiorDistance(c, Complex(zr, zi), iter + 1 - (saveAt >> 1));
+            if (interior > 0)
+            {
+                fillRadius = interior / 4 / pixel;
+                return maxIter;
+            }
+            checking = false;
+        }
+        if (iter + 1 == saveAt)
+        {
+            sr = zr;
+            si = zi;
+            saveAt <<= 1;
+            checking = true;
+        }
+    }
+
+    // Still bounded without settling: too close to the boundary to tell
+    return maxIter;
+}
+
+void DistanceEstimatorMandelbrotCalculator::fillDisk(int x, int y, double radius, int value)
+{
+    // One span per row, clipped to the image. Big disks mostly overlap pixels
+    // that are already known, which the bit plane skips a word at a time.
+    const int reach = int(radius);
+    for (int j = std::max(0, y - reach); j <= std::min(height - 1, y + reach); ++j)
+    {
+        const int half = int(std::sqrt(radius * radius - double(j - y) * (j - y)));
+        const size_t row = size_t(j) * width;
+        known.setRange(row + std::max(0, x - half), row + std::min(width - 1, x + half) + 1,
+                       [&](size_t p) { data[p] = value; });
+    }
+}
+
+void DistanceEstimatorMandelbrotCalculator::compute(std::function<void()> progressCallback)
+{
+    data.assign(width * height, 0);
+    known.clear();
+    pixel = std::min(stepr, stepi);
+
+    for (int step = COARSE_STEP; step >= 1; step /= 2)
+    {
+        for (int y = 0; y < height; y += step)
+        {
+            for (int x = 0; x < width; x += step)
+            {
+                const unsigned p = y * width + x;
+                if (known.testAndSet(p))
+                    continue;
+
+                double fillRadius;
+                data[p] = evaluate(Complex(minr + x * stepr, mini + y * stepi), fillRadius);
+                // Interior points fill their whole disk, exterior ones the part
+                // where the shade saturates
+                if (fillRadius > 1)
+                    fillDisk(x, y, fillRadius, data[p] == maxIter ? maxIter : exteriorValue(SATURATION_PIXELS));
+            }
+        }
+
+        // Update display after each pass (skip in speed mode)
+        if (!speedMode && progressCallback)
+            progressCallback();
+    }
+}
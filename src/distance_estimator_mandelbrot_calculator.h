@@ -0,0 +1,52 @@
+#pragma once
+
+#include "storage_mandelbrot_calculator.h"
+#include "bit_plane.h"
+#include <complex>
+
+// Distance estimation: the derivative dz/dc is iterated along with z, and an
+// escaping pixel is shaded by its estimated distance to the set instead of its
+// iteration count, so filaments show as lines however thin they get.
+// The estimates also save iterations. By the Koebe 1/4 theorem, the disk of a
+// quarter of the exterior estimate around a point holds no point of the set. The
+// disk of a quarter of the interior estimate of a point in a hyperbolic component
+// (from its attracting cycle) holds no boundary point. Pixels in such a disk are
+// filled without iterating when their value is known: inside the set, or far
+// enough outside that the shading saturates. Pixels are visited coarse to fine,
+// so the large disks come first.
+class DistanceEstimatorMandelbrotCalculator : public StorageMandelbrotCalculator
+{
+public:
+    DistanceEstimatorMandelbrotCalculator(int width, int height);
+
+    void compute(std::function<void()> progressCallback) override;
+
+    std::string getEngineName() const override { return "   de"; }
+
+private:
+    using Complex = std::complex<double>;
+
+    // Grid step of the first pass, halved at each pass down to single pixels
+    static constexpr int COARSE_STEP = 16;
+    // Squared escape radius: the estimate gets exact as the radius grows
+    static constexpr double ESCAPE_RADIUS2 = 1e10;
+    // Squared distance under which an orbit point counts as a return to the saved one
+    static constexpr double CYCLE_DISTANCE2 = 1e-24;
+    // Distance (in pixels) from which every exterior pixel gets the same shade
+    static constexpr double SATURATION_PIXELS = 8;
+    // Shades of the exterior, from on the boundary to saturated
+    static constexpr int DE_LEVELS = 16;
+
+    BitPlane known; // Evaluated or filled
+    double pixel;   // Pixel size in the plane
+
+    // Value of the point c, and the radius (in pixels) of the disk around it whose
+    // pixels have that value too (0 when there is none)
+    int evaluate(const Complex &c, double &fillRadius) const;
+    // Shade of an exterior point at the given distance (in pixels)
+    int exteriorValue(double distance) const;
+    // Interior distance estimate of c, whose orbit has settled on a cycle of the
+    // given period near z (0 when the cycle is not attracting)
+    double interiorDistance(const Complex &c, Complex z, int period) const;
+    void fillDisk(int x, int y, double radius, int value);
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cmath>
+
+// Unevaluated sum hi + lo of two doubles with |lo| <= ulp(hi) / 2, about 106 bits
+// of mantissa. Built from error-free transformations: twoSum recovers the rounding
+// error of an addition and std::fma the one of a product, so the operators below
+// stay exact to a few units of 2^-104 whatever floating point contraction the
+// compiler applies.
+struct DoubleDouble
+{
+    double hi, lo;
+
+    // Relative precision of the format
+    static constexpr double EPSILON = 0x1p-104;
+
+    DoubleDouble(double x = 0.0) : hi(x), lo(0.0) {}
+    DoubleDouble(double h, double l) : hi(h), lo(l) {}
+
+    double toDouble() const { return hi + lo; }
+
+    // s + e == a + b exactly
+    static DoubleDouble twoSum(double a, double b)
+    {
+        double s = a + b;
+        double bb = s - a;
+        double e = (a - (s - bb)) + (b - bb);
+        return {s, e};
+    }
+
+    // Same as twoSum when |a| >= |b|
+    static DoubleDouble quickTwoSum(double a, double b)
+    {
+        double s = a + b;
+        return {s, b - (s - a)};
+    }
+
+    // p + e == a * b exactly
+    static DoubleDouble twoProd(double a, double b)
+    {
+        double p = a * b;
+        return {p, std::fma(a, b, -p)};
+    }
+};
+
+inline DoubleDouble operator-(const DoubleDouble &a)
+{
+    return {-a.hi, -a.lo};
+}
+
+inline DoubleDouble operator+(const DoubleDouble &a, const DoubleDouble &b)
+{
+    DoubleDouble s = DoubleDouble::twoSum(a.hi, b.hi);
+    DoubleDouble t = DoubleDouble::twoSum(a.lo, b.lo);
+    s.lo += t.hi;
+    s = DoubleDouble::quickTwoSum(s.hi, s.lo);
+    s.lo += t.lo;
+    return DoubleDouble::quickTwoSum(s.hi, s.lo);
+}
+
+inline DoubleDouble operator-(const DoubleDouble &a, const DoubleDouble &b)
+{
+    return a + -b;
+}
+
+inline DoubleDouble operator*(const DoubleDouble &a, const DoubleDouble &b)
+{
+    DoubleDouble p = DoubleDouble::twoProd(a.hi, b.hi);
+    p.lo += a.hi * b.lo + a.lo * b.hi;
+    return DoubleDouble::quickTwoSum(p.hi, p.lo);
+}
+
+inline DoubleDouble &operator+=(DoubleDouble &a, const DoubleDouble &b)
+{
+    return a = a + b;
+}
+
+inline DoubleDouble &operator-=(DoubleDouble &a, const DoubleDouble &b)
+{
+    return a = a - b;
+}
+
+inline DoubleDouble &operator*=(DoubleDouble &a, const DoubleDouble &b)
+{
+    return a = a * b;
+}
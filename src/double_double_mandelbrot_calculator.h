@@ -0,0 +1,31 @@
+#pragma once
+
+#include "border_mandelbrot_calculator.h"
+
+// Direct iteration in double-double arithmetic, for views below double resolution
+// where perturbation is not wanted (no reference orbit, no glitches to worry about).
+// About ten times slower than double, so it is only worth it past 1e-15. Pixels
+// are visited by the boundary tracing of BorderMandelbrotCalculator.
+class DoubleDoubleMandelbrotCalculator : public BorderMandelbrotCalculator
+{
+public:
+    DoubleDoubleMandelbrotCalculator(int width, int height);
+
+    void compute(std::function<void()> progressCallback) override;
+
+    std::string getEngineName() const override { return "   dd"; }
+
+    // Limited by double-double instead of double
+    FloatExp getMinDiam() const override;
+
+protected:
+    void iteratePixels(const unsigned *pixels, unsigned count) override;
+
+private:
+    // Reference point rounded to double-double once per compute
+    DoubleDouble refrDD, refiDD;
+
+    // Evaluates pixels in batches with the kernel of the interior checks in use
+    template <bool PERIODIC, class Bailout>
+    void iterateBatches(const unsigned *pixels, unsigned count, const Bailout &bailout);
+};
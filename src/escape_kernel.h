@@ -0,0 +1,449 @@
+#pragma once
+
+#include "interior_check.h"
+#include "double_double.h"
+#include "newton_polynomial.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Shared escape-time kernel. Every CPU engine evaluates its pixels through
+// EscapeKernel, picking:
+// - the scalar type (float, double or DoubleDouble),
+// - the number of lanes (1 for a plain loop, more for a masked batch the compiler
+//   vectorizes),
+// - the formula iterated from z = c,
+// - the bailout policy deciding when a point is done and what it reports (and
+//   whether an attracted orbit stops early, see DerivativeEscapeRadius),
+// - whether Brent periodicity checking is compiled in.
+// Traversals (row scan, boundary tracing, grid tiles) only deal with pixel
+// coordinates, so any of them can run any kernel variant.
+// Helpers are static so the ISA-specific translation units keep their own copies.
+
+// Leading part of a value, used for the escape test (the hi part of a DoubleDouble)
+static inline float leadingPart(float x) { return x; }
+static inline double leadingPart(double x) { return x; }
+static inline double leadingPart(const DoubleDouble &x) { return x.hi; }
+
+// |x| in the precision periodicity checking needs
+static inline float magnitude(float x) { return std::abs(x); }
+static inline double magnitude(double x) { return std::abs(x); }
+static inline double magnitude(const DoubleDouble &x) { return std::abs(x.toDouble()); }
+
+// z -> z^2 + c. INTERIOR_CHECK settles the main cardioid and period-2 bulb without
+// iterating; engines whose views sit below double resolution turn it off, the
+// closed-form test runs in double and would misjudge points on the boundary.
+template <bool INTERIOR_CHECK = true>
+struct MandelbrotFormula
+{
+    template <class T>
+    static bool isInterior(const T &cr, const T &ci)
+    {
+        if constexpr (INTERIOR_CHECK)
+            return isInMainCardioidOrBulb(cr, ci);
+        else
+            return false;
+    }
+
+    template <class T>
+    static void step(T &zr, T &zi, const T &cr, const T &ci)
+    {
+        T r2 = zr * zr;
+        T i2 = zi * zi;
+        T ri = zr * zi;
+        zi = ri + ri + ci;
+        zr = r2 - i2 + cr;
+    }
+};
+
+// Newton's method on z^3 - 1: z -> z - (z^3 - 1) / 3z^2
+struct NewtonCubicFormula
+{
+    static constexpr int ROOT_COUNT = 3;
+    static constexpr double ROOTS[ROOT_COUNT][2] = {{1, 0.00001}, {-.5, .86603}, {-.5, -.8660}};
+
+    template <class T>
+    static bool isInterior(const T &, const T &)
+    {
+        return false;
+    }
+
+    template <class T>
+    static void step(T &zr, T &zi, const T &, const T &)
+    {
+        // Same step as z - (z^3 - 1) / 3z^2 rewritten as 2z/3 + 1/(3z^2), with
+        // 1/z^2 = conj(z^2) / |z|^4: one reciprocal instead of two divisions
+        T sr = zr * zr - zi * zi;
+        T si = zr * zi + zi * zr;
+        T norm = zr * zr + zi * zi;
+        T inv = T(1) / (T(3) * norm * norm);
+        zr = T(2.0 / 3.0) * zr + sr * inv;
+        zi = T(2.0 / 3.0) * zi - si * inv;
+    }
+};
+
+// Newton's method on a NewtonPolynomial, p and p' by Horner's rule. DEGREE fixes the
+// degree at compile time so the loop unrolls inside the lanes; 0 reads it from the
+// polynomial, for degrees without their own instantiation.
+template <int DEGREE>
+struct PolynomialNewtonFormula
+{
+    const double *coefficients; // Highest degree first, monic
+    int degree;
+
+    explicit PolynomialNewtonFormula(const NewtonPolynomial &polynomial)
+        : coefficients(polynomial.getCoefficients().data()), degree(polynomial.getDegree())
+    {
+    }
+
+    template <class T>
+    bool isInterior(const T &, const T &) const
+    {
+        return false;
+    }
+
+    template <class T>
+    void step(T &zr, T &zi, const T &, const T &) const
+    {
+        // The polynomial is monic: after the first step p = z + a_1 and p' = 1
+        const int n = DEGREE > 0 ? DEGREE : degree;
+        T pr = zr + T(coefficients[1]), pi = zi;
+        T dr = T(1), di = T(0);
+        for (int k = 2; k <= n; ++k)
+        {
+            // p' = p' z + p, then p = p z + a_k
+            T ndr = dr * zr - di * zi + pr;
+            T ndi = dr * zi + di * zr + pi;
+            T npr = pr * zr - pi * zi + T(coefficients[k]);
+            T npi = pr * zi + pi * zr;
+            dr = ndr;
+            di = ndi;
+            pr = npr;
+            pi = npi;
+        }
+
+        // z - p / p' with one reciprocal
+        T inv = T(1) / (dr * dr + di * di);
+        zr = zr - (pr * dr + pi * di) * inv;
+        zi = zi - (pi * dr - pr * di) * inv;
+    }
+};
+
+// Bailout of the escape-time fractals: done once |z| >= 2, reports the iteration count
+struct EscapeRadius
+{
+    template <class T>
+    static bool done(const T &zr, const T &zi)
+    {
+        T r2 = zr * zr;
+        T i2 = zi * zi;
+        using Real = decltype(leadingPart(r2));
+        return leadingPart(r2) + leadingPart(i2) >= Real(4);
+    }
+
+    template <class T>
+    static int result(int iter, const T &, const T &, int)
+    {
+        return iter;
+    }
+};
+
+// EscapeRadius that also stops orbits captured by an attracting cycle. The kernel
+// carries dz/dz0 along the orbit of MandelbrotFormula (d <- 2 z d). On an attracting
+// cycle it shrinks by the multiplier every period, so it drops below the threshold
+// long before the orbit repeats closely enough for periodicity checking; escaping
+// orbits make it grow. An attracted point reports maxIter.
+struct DerivativeEscapeRadius : EscapeRadius
+{
+    double threshold; // Squared |dz/dz0|
+
+    explicit DerivativeEscapeRadius(double threshold) : threshold(threshold) {}
+
+    // Derivative after the step from z
+    template <class T>
+    static void track(T &dr, T &di, const T &zr, const T &zi)
+    {
+        T nr = zr * dr - zi * di;
+        T ni = zr * di + zi * dr;
+        dr = nr + nr;
+        di = ni + ni;
+    }
+
+    template <class T>
+    bool attracted(const T &dr, const T &di) const
+    {
+        using Real = decltype(leadingPart(dr));
+        return leadingPart(dr * dr + di * di) < Real(threshold);
+    }
+};
+
+// Bailout policies that stop attracted orbits through a dz/dz0 accumulator
+template <class Bailout>
+concept TracksDerivative = requires(const Bailout &bailout, double d) {
+    Bailout::track(d, d, d, d);
+    bailout.attracted(d, d);
+};
+
+// Polynomial stand-ins for the libm calls of the Newton shading. The shade ends up
+// as an integer offset in a palette band, so about 1e-6 is plenty, and unlike the
+// library calls they inline into the batch loops.
+
+// log2(x) for x >= 0: exponent from the bits, mantissa (brought into [sqrt(1/2),
+// sqrt(2))) through the atanh series of log
+static inline double fastLog2(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    double exponent = double(int((bits >> 52) & 0x7ff) - 1023);
+    bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+    double m;
+    std::memcpy(&m, &bits, sizeof m);
+    bool high = m > 1.4142135623730951;
+    m = high ? m * 0.5 : m;
+    exponent = high ? exponent + 1.0 : exponent;
+    double t = (m - 1.0) / (m + 1.0);
+    double t2 = t * t;
+    double logM = 2.0 * t * (1.0 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7 + t2 * (1.0 / 9)))));
+    return exponent + logM * 1.4426950408889634;
+}
+
+// cos(x) as sin(pi/2 - |x|) once |x| is brought into [-pi, pi] (truncation, not
+// floor, keeps it vectorizable), Taylor series of sin
+static inline double fastCos(double x)
+{
+    constexpr double TWO_PI = 6.283185307179586;
+    x = std::abs(x);
+    x -= TWO_PI * double(static_cast<long long>(x * (1.0 / TWO_PI) + 0.5));
+    double y = 1.5707963267948966 - std::abs(x);
+    double y2 = y * y;
+    return y * (1.0 + y2 * (-1.0 / 6 + y2 * (1.0 / 120 + y2 * (-1.0 / 5040 + y2 * (1.0 / 362880)))));
+}
+
+// Offset in the palette band of a root for a point that got within the squared
+// distance threshold of it after iter steps: the band is shaded by the (smoothed)
+// convergence speed, the fraction of the last step being
+// log2(log(dist) / log(threshold))
+static inline int newtonShade(int iter, double dist, double threshold, int bandSize)
+{
+    double fraction = fastLog2(fastLog2(dist) * (1.0 / fastLog2(threshold)));
+    return int(bandSize * (0.75 + 0.25 * fastCos(0.25 * (double(iter - 1) - fraction))));
+}
+
+// Bailout of Newton fractals: done once z is close to a root of the formula.
+// Reports a palette band per root, shaded by the (smoothed) convergence speed.
+template <class Formula>
+struct RootConvergence
+{
+    static constexpr double THRESHOLD = .00001; // Squared distance to the root
+
+    template <class T>
+    static bool done(const T &zr, const T &zi)
+    {
+        bool near = false;
+        for (int r = 0; r < Formula::ROOT_COUNT; ++r)
+        {
+            T dr = zr - T(Formula::ROOTS[r][0]);
+            T di = zi - T(Formula::ROOTS[r][1]);
+            near |= (dr * dr + di * di <= T(THRESHOLD));
+        }
+        return near;
+    }
+
+    template <class T>
+    static int result(int iter, const T &zr, const T &zi, int maxIter)
+    {
+        // Only used once done() held: the nearest root is within THRESHOLD. Picked
+        // without branches so the result loop of a batch vectorizes too.
+        double nearest = THRESHOLD * 2;
+        int root = Formula::ROOT_COUNT;
+        for (int r = 0; r < Formula::ROOT_COUNT; ++r)
+        {
+            double dr = zr - Formula::ROOTS[r][0];
+            double di = zi - Formula::ROOTS[r][1];
+            double dist = dr * dr + di * di;
+            root = dist < nearest ? r : root;
+            nearest = std::min(dist, nearest);
+        }
+
+        const int bandSize = maxIter / Formula::ROOT_COUNT;
+        return (root * bandSize) + newtonShade(iter, nearest, THRESHOLD, bandSize);
+    }
+};
+
+// Bailout of PolynomialNewtonFormula: done once z is within THRESHOLD of the root the
+// grid of the polynomial names for it, a band per root like RootConvergence
+struct NearestRootConvergence
+{
+    const NewtonPolynomial &polynomial;
+
+    bool done(double zr, double zi) const
+    {
+        return polynomial.isConverged(zr, zi);
+    }
+
+    int result(int iter, double zr, double zi, int maxIter) const
+    {
+        int root = polynomial.candidateRoot(zr, zi);
+        double dr = zr - polynomial.rootR(root);
+        double di = zi - polynomial.rootI(root);
+        const int bandSize = maxIter / polynomial.getRootCount();
+        return (root * bandSize) + newtonShade(iter, dr * dr + di * di, NewtonPolynomial::THRESHOLD, bandSize);
+    }
+};
+
+// maxIter is an int, or a std::integral_constant when the budget is known at compile time.
+// Policies are called through the formula and bailout arguments: the stateless ones
+// above are default-constructed, policies with data (a polynomial, its roots) are
+// passed in by the engine.
+template <class T, int LANES, class Formula, class Bailout, bool PERIODIC>
+struct EscapeKernel
+{
+    static_assert(LANES >= 1, "a kernel needs at least one lane");
+
+    // Value of the point c = (cr, ci)
+    template <class Limit>
+    static int iterate(const T &cr, const T &ci, Limit maxIter, double periodEps,
+                       const Formula &formula = Formula(), const Bailout &bailout = Bailout())
+    {
+        if (formula.isInterior(cr, ci))
+            return maxIter;
+
+        T zr = cr, zi = ci;
+        int iter;
+
+        // Brent cycle detection: compare against a point saved at power-of-two iterations
+        T savedR = zr, savedI = zi;
+        int saveAt = 1;
+        // dz/dz0, for bailouts that track it
+        T dr = T(1), di = T(0);
+
+        for (iter = 0; iter < maxIter; ++iter)
+        {
+            if (bailout.done(zr, zi))
+                break;
+
+            if constexpr (TracksDerivative<Bailout>)
+                bailout.track(dr, di, zr, zi);
+            formula.step(zr, zi, cr, ci);
+
+            if constexpr (TracksDerivative<Bailout>)
+            {
+                if (bailout.attracted(dr, di))
+                    return maxIter; // Attracting cycle: point is inside the set
+            }
+
+            if constexpr (PERIODIC)
+            {
+                if (magnitude(zr - savedR) + magnitude(zi - savedI) < periodEps)
+                    return maxIter; // Orbit repeats: point is inside the set
+                if (iter == saveAt)
+                {
+                    savedR = zr;
+                    savedI = zi;
+                    saveAt *= 2;
+                }
+            }
+        }
+
+        return iter < maxIter ? bailout.result(iter, zr, zi, maxIter) : int(maxIter);
+    }
+
+    // Values of count <= LANES points, evaluated side by side. Branchless lane
+    // updates under a mask so the compiler vectorizes the inner loop; a batch runs
+    // until its slowest lane is done, lanes are not refilled.
+    template <class Limit>
+    static void iterateBatch(const T *cr, const T *ci, int count, Limit maxIter, double periodEps, int *out,
+                             const Formula &formula = Formula(), const Bailout &bailout = Bailout())
+    {
+        using Real = decltype(magnitude(T()));
+        const Real eps = static_cast<Real>(periodEps);
+
+        // 64-bit mask and counters to match double width (helps vectorization)
+        alignas(64) T pr[LANES], pi[LANES];
+        alignas(64) T zr[LANES], zi[LANES];
+        alignas(64) long long iters[LANES];
+        alignas(64) long long mask[LANES]; // 1 if active, 0 if done
+        // Orbit point saved for periodicity checking and the iteration of the next save
+        alignas(64) T sr[LANES], si[LANES];
+        alignas(64) long long saveAt[LANES];
+        // dz/dz0 of each lane, for bailouts that track it
+        alignas(64) T dr[LANES], di[LANES];
+
+        // Padding lanes duplicate the first point so the loop size stays constant
+        for (int i = 0; i < LANES; ++i)
+        {
+            int q = (i < count) ? i : 0;
+            pr[i] = zr[i] = sr[i] = cr[q];
+            pi[i] = zi[i] = si[i] = ci[q];
+            saveAt[i] = 1;
+            dr[i] = T(1);
+            di[i] = T(0);
+            bool inside = formula.isInterior(pr[i], pi[i]);
+            iters[i] = inside ? int(maxIter) : 0;
+            mask[i] = (i < count && !inside) ? 1 : 0;
+        }
+
+        for (int k = 0; k < maxIter; ++k)
+        {
+            for (int i = 0; i < LANES; ++i)
+            {
+                bool stop = bailout.done(zr[i], zi[i]);
+                T nr = zr[i], ni = zi[i];
+                formula.step(nr, ni, pr[i], pi[i]);
+
+                mask[i] = mask[i] & (!stop);
+
+                if constexpr (TracksDerivative<Bailout>)
+                {
+                    // Derivative of the same step, stopped with z
+                    T ndr = dr[i], ndi = di[i];
+                    bailout.track(ndr, ndi, zr[i], zi[i]);
+                    dr[i] = mask[i] ? ndr : dr[i];
+                    di[i] = mask[i] ? ndi : di[i];
+
+                    // An attracted lane is inside the set: stop it at maxIter
+                    long long inside = mask[i] & bailout.attracted(dr[i], di[i]);
+                    iters[i] = inside ? int(maxIter) : iters[i];
+                    mask[i] = mask[i] & !inside;
+                }
+
+                // Update z only while active
+                zr[i] = mask[i] ? nr : zr[i];
+                zi[i] = mask[i] ? ni : zi[i];
+
+                if constexpr (PERIODIC)
+                {
+                    // A repeating orbit is inside the set: stop the lane at maxIter
+                    Real dist = magnitude(zr[i] - sr[i]) + magnitude(zi[i] - si[i]);
+                    long long repeat = mask[i] & (dist < eps);
+                    iters[i] = repeat ? int(maxIter) : iters[i];
+                    mask[i] = mask[i] & !repeat;
+
+                    bool save = mask[i] & (iters[i] == saveAt[i]);
+                    sr[i] = save ? zr[i] : sr[i];
+                    si[i] = save ? zi[i] : si[i];
+                    saveAt[i] = save ? saveAt[i] * 2 : saveAt[i];
+                }
+
+                iters[i] += mask[i];
+            }
+
+            // Checked outside the vector loop to keep it branch free
+            long long active = 0;
+            for (int i = 0; i < LANES; ++i)
+                active |= mask[i];
+            if (active == 0)
+                break;
+        }
+
+        // Results of every lane first, selected afterwards: a loop without branches
+        // so costly results (Newton shading) vectorize as well
+        alignas(64) int values[LANES];
+        for (int i = 0; i < LANES; ++i)
+            values[i] = bailout.result(static_cast<int>(iters[i]), zr[i], zi[i], maxIter);
+        for (int i = 0; i < count; ++i)
+            out[i] = iters[i] < maxIter ? values[i] : int(maxIter);
+    }
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+// Double mantissa with a separate 64-bit exponent: value = m * 2^e, with
+// 0.5 <= |m| < 1 or m == 0. Same 53 bits of precision as double but no underflow,
+// for view sizes, pixel offsets and perturbation deltas of views deeper than about 1e-300.
+// Renormalization rewrites the exponent bits of m instead of calling frexp/ldexp, so
+// the operators are branch free and vectorize like plain double arithmetic.
+// The free functions below (sqrt, hypot, isfinite, toDouble) mirror their double
+// counterparts, so code templated on the real type takes either.
+struct FloatExp
+{
+    double m;
+    int64_t e;
+
+    // Exponent of zero, far enough below any real value that additions ignore it
+    static constexpr int64_t ZERO_EXP = -(int64_t(1) << 40);
+
+    FloatExp(double x = 0.0) { *this = normalize(x, 0); }
+    FloatExp(double mantissa, int64_t exponent) : m(mantissa), e(exponent) {}
+
+    // Clamps to 0 or infinity outside the range of double
+    double toDouble() const
+    {
+        return std::ldexp(m, static_cast<int>(std::clamp<int64_t>(e, -2000, 2000)));
+    }
+
+    // Binary logarithm of |value|, -infinity for 0
+    double log2() const
+    {
+        return m == 0.0 ? -HUGE_VAL : static_cast<double>(e) + std::log2(std::abs(m));
+    }
+
+    // m * 2^e with m any finite double, subnormal mantissas read as 0
+    static FloatExp normalize(double m, int64_t e)
+    {
+        uint64_t bits = std::bit_cast<uint64_t>(m);
+        int64_t exponent = static_cast<int64_t>((bits >> 52) & 0x7ff);
+        bool zero = exponent == 0;
+        // Keep sign and fraction, force the biased exponent of [0.5, 1)
+        bits = (bits & ~(uint64_t(0x7ff) << 52)) | (uint64_t(1022) << 52);
+        return {zero ? 0.0 : std::bit_cast<double>(bits), zero ? ZERO_EXP : e + exponent - 1022};
+    }
+
+    // 2^-shift for 0 <= shift, exactly 0 from 1023 on
+    static double scaleDown(int64_t shift)
+    {
+        uint64_t biased = static_cast<uint64_t>(1023 - std::min<int64_t>(shift, 1023));
+        return std::bit_cast<double>(biased << 52);
+    }
+};
+
+inline FloatExp operator-(const FloatExp &a)
+{
+    return {-a.m, a.e};
+}
+
+inline FloatExp operator+(const FloatExp &a, const FloatExp &b)
+{
+    // Align the smaller operand on the exponent of the larger one
+    bool aBig = a.e >= b.e;
+    const FloatExp &big = aBig ? a : b;
+    const FloatExp &small = aBig ? b : a;
+    return FloatExp::normalize(big.m + small.m * FloatExp::scaleDown(big.e - small.e), big.e);
+}
+
+inline FloatExp operator-(const FloatExp &a, const FloatExp &b)
+{
+    return a + -b;
+}
+
+inline FloatExp operator*(const FloatExp &a, const FloatExp &b)
+{
+    return FloatExp::normalize(a.m * b.m, a.e + b.e);
+}
+
+inline FloatExp operator/(const FloatExp &a, const FloatExp &b)
+{
+    return FloatExp::normalize(a.m / b.m, a.e - b.e);
+}
+
+inline bool operator<(const FloatExp &a, const FloatExp &b)
+{
+    return (a - b).m < 0.0;
+}
+
+inline bool operator>(const FloatExp &a, const FloatExp &b)
+{
+    return b < a;
+}
+
+inline FloatExp sqrt(const FloatExp &x)
+{
+    // Even exponent, so it halves exactly: m in [0.25, 1)
+    int64_t odd = x.e & 1;
+    return FloatExp::normalize(std::sqrt(odd ? x.m * 0.5 : x.m), (x.e + odd) / 2);
+}
+
+inline FloatExp hypot(const FloatExp &x, const FloatExp &y)
+{
+    return sqrt(x * x + y * y);
+}
+
+inline bool isfinite(const FloatExp &x)
+{
+    return std::isfinite(x.m);
+}
+
+inline double toDouble(double x)
+{
+    return x;
+}
+
+inline double toDouble(const FloatExp &x)
+{
+    return x.toDouble();
+}
+
+inline FloatExp &operator+=(FloatExp &a, const FloatExp &b)
+{
+    return a = a + b;
+}
+
+inline FloatExp &operator-=(FloatExp &a, const FloatExp &b)
+{
+    return a = a - b;
+}
+
+inline FloatExp &operator*=(FloatExp &a, const FloatExp &b)
+{
+    return a = a * b;
+}
+
+inline FloatExp &operator/=(FloatExp &a, const FloatExp &b)
+{
+    return a = a / b;
+}
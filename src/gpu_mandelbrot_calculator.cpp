@@ -55,7 +55,7 @@ void GpuMandelbrotCalculator::compute(std::function<void()> progressCallback)
     glUniform1d(locMinI, mini);
     glUniform1d(locMaxR, maxr);
     glUniform1d(locMaxI, maxi);
-    glUniform1i(locMaxIter, MAX_ITER);
+    glUniform1i(locMaxIter, maxIter);
 
     // Draw full screen quad using VAO
     glBindVertexArray(vao);
@@ -106,8 +106,8 @@ void GpuMandelbrotCalculator::compute(std::function<void()> progressCallback)
 
             // Decode iteration count
             int iter = r + (g * 256);
-            if (iter > MAX_ITER)
-                iter = MAX_ITER;
+            if (iter > maxIter)
+                iter = maxIter;
 
             dstRow[x] = iter;
         }
@@ -216,8 +216,16 @@ void GpuMandelbrotCalculator::initShaders()
             $PRECISION_TYPE i2;
             
             int iter = 0;
+
+            // Main cardioid and period-2 bulb never escape (see interior_check.h)
+            $PRECISION_TYPE xq = x - $PRECISION_TYPE(0.25);
+            $PRECISION_TYPE q = xq * xq + y * y;
+            $PRECISION_TYPE xb = x + $PRECISION_TYPE(1.0);
+            bool inside = q * (q + xq) <= $PRECISION_TYPE(0.25) * y * y ||
+                          xb * xb + y * y <= $PRECISION_TYPE(0.0625);
+
             // We can use a dynamic loop in GLSL 4.0
-            for (int k = 0; k < maxIter; ++k) {
+            for (int k = 0; k < (inside ? 0 : maxIter); ++k) {
                 r2 = r * r;
                 i2 = i * i;
                 
@@ -232,7 +240,7 @@ void GpuMandelbrotCalculator::initShaders()
             }
             
             // If loop completed without breaking, we're in the set
-            if (iter == 0 && r2 + i2 < $PRECISION_TYPE(4.0)) {
+            if (inside || (iter == 0 && r2 + i2 < $PRECISION_TYPE(4.0))) {
                 iter = maxIter;
             }
             
@@ -2,13 +2,22 @@
 #include "simd_mandelbrot_calculator.h"
 #include "gpu_mandelbrot_calculator.h"
 #include "standard_mandelbrot_calculator.h"
-#include "standard_newton_calculator.h"
+#include "simd_newton_calculator.h"
+#include "perturbation_mandelbrot_calculator.h"
+#include "double_double_mandelbrot_calculator.h"
+#include "parallel_border_mandelbrot_calculator.h"
+#include "mariani_silver_mandelbrot_calculator.h"
+#include "successive_refinement_mandelbrot_calculator.h"
+#include "distance_estimator_mandelbrot_calculator.h"
+#include <algorithm>
+#include <cmath>
 #include <format>
 #include <thread>
 #include <vector>
 
 GridMandelbrotCalculator::GridMandelbrotCalculator(int w, int h, int rows, int cols)
-    : StorageMandelbrotCalculator(w, h), gridRows(rows), gridCols(cols), engineType(EngineType::BORDER)
+    : StorageMandelbrotCalculator(w, h), gridRows(rows), gridCols(cols), engineType(EngineType::BORDER),
+      mirrorSum(-1), rowBegin(0), rowEnd(h)
 {
     tileInfos.resize(gridRows * gridCols);
 
@@ -19,10 +28,53 @@ GridMandelbrotCalculator::GridMandelbrotCalculator(int w, int h, int rows, int c
     updateBounds(-0.5, 0.0, 3.0);
 }
 
+void GridMandelbrotCalculator::findMirrorRows()
+{
+    mirrorSum = -1;
+    rowBegin = 0;
+    rowEnd = height;
+
+    // The Newton fractal of a general polynomial has no real-axis symmetry
+    if (engineType == EngineType::NEWTON)
+        return;
+
+    // Row y is at Im(c) = refi + dmini + y * stepi, so conjugate rows add up to
+    // -2 (refi + dmini) / stepi. The sum is taken in high precision, which keeps it
+    // exact at any depth.
+    FloatExp axis = (refi + HighPrecision(deepMinI)).toFloatExp();
+    double sum = (FloatExp(-2.0) * axis / deepStepI).toDouble();
+    double rounded = std::round(sum);
+
+    // Only views whose rows land on each other's samples: a fractional offset
+    // would shift the copied rows. Outside [1, 2 height - 3] no row is mirrored.
+    constexpr double MIRROR_TOLERANCE = 1e-6; // Pixels
+    if (!(std::abs(sum - rounded) <= MIRROR_TOLERANCE) || rounded < 1.0 || rounded > 2.0 * height - 3.0)
+        return;
+    int s = static_cast<int>(rounded);
+
+    // Compute the half on the side of the rows without a mirror, axis row included
+    if (s <= height - 1)
+        rowBegin = (s + 1) / 2;
+    else
+        rowEnd = s / 2 + 1;
+
+    // Every tile needs at least one row
+    if (rowEnd - rowBegin < gridRows)
+    {
+        rowBegin = 0;
+        rowEnd = height;
+        return;
+    }
+    mirrorSum = s;
+}
+
 void GridMandelbrotCalculator::calculateTileGeometry()
 {
+    findMirrorRows();
+
     // Calculate tile dimensions
-    // Distribute pixels as evenly as possible across tiles
+    // Distribute pixels as evenly as possible across tiles, rows only over the
+    // computed ones
 
     for (int row = 0; row < gridRows; ++row)
     {
@@ -33,32 +85,36 @@ void GridMandelbrotCalculator::calculateTileGeometry()
 
             // Calculate pixel boundaries for this tile
             tile.startX = (col * width) / gridCols;
-            tile.startY = (row * height) / gridRows;
+            tile.startY = rowBegin + (row * (rowEnd - rowBegin)) / gridRows;
 
             int endX = ((col + 1) * width) / gridCols;
-            int endY = ((row + 1) * height) / gridRows;
+            int endY = rowBegin + ((row + 1) * (rowEnd - rowBegin)) / gridRows;
 
             tile.width = endX - tile.startX;
             tile.height = endY - tile.startY;
 
-            // Calculate complex plane bounds for this tile
-            tile.minR = minr + tile.startX * stepr;
-            tile.minI = mini + tile.startY * stepi;
-            tile.maxR = minr + endX * stepr;
-            tile.maxI = mini + endY * stepi;
+            // Calculate complex plane bounds for this tile, relative to the
+            // reference point so they keep their precision on deep zooms
+            tile.minR = deepMinR + FloatExp(tile.startX) * deepStepR;
+            tile.minI = deepMinI + FloatExp(tile.startY) * deepStepI;
+            tile.maxR = deepMinR + FloatExp(endX) * deepStepR;
+            tile.maxI = deepMinI + FloatExp(endY) * deepStepI;
         }
     }
 }
 
-void GridMandelbrotCalculator::updateBounds(double new_cre, double new_cim, double new_diam)
+void GridMandelbrotCalculator::createTiles()
 {
-    ZoomMandelbrotCalculator::updateBounds(new_cre, new_cim, new_diam);
-
-    // Calculate geometry for all tiles
-    calculateTileGeometry();
-
     // (Re)create tile calculators with correct dimensions
     tiles.clear();
+
+    // Perturbation tiles share the reference orbit and series of the whole view
+    std::shared_ptr<PerturbationView> view;
+    if (engineType == EngineType::PERTURBATION)
+        view = std::make_shared<PerturbationView>(refr, refi, deepMinR, deepMinI,
+                                                  deepMinR + FloatExp(width) * deepStepR,
+                                                  deepMinI + FloatExp(height) * deepStepI, maxIter);
+
     for (int i = 0; i < gridRows * gridCols; ++i)
     {
         const TileInfo &tile = tileInfos[i];
@@ -66,13 +122,45 @@ void GridMandelbrotCalculator::updateBounds(double new_cre, double new_cim, doub
 
         if (engineType == EngineType::STANDARD)
         {
-            // calculator = std::make_unique<StandardMandelbrotCalculator>(tile.width, tile.height);
-            calculator = std::make_unique<StandardNewtonCalculator>(tile.width, tile.height);
+            calculator = std::make_unique<StandardMandelbrotCalculator>(tile.width, tile.height);
+        }
+        else if (engineType == EngineType::NEWTON)
+        {
+            auto newton = std::make_unique<SimdNewtonCalculator>(tile.width, tile.height);
+            if (newtonPolynomial)
+                newton->setPolynomial(newtonPolynomial);
+            calculator = std::move(newton);
         }
         else if (engineType == EngineType::SIMD)
         {
             calculator = std::make_unique<SimdMandelbrotCalculator>(tile.width, tile.height);
         }
+        else if (engineType == EngineType::DISTANCE_ESTIMATOR)
+        {
+            calculator = std::make_unique<DistanceEstimatorMandelbrotCalculator>(tile.width, tile.height);
+        }
+        else if (engineType == EngineType::PERTURBATION)
+        {
+            auto perturbation = std::make_unique<PerturbationMandelbrotCalculator>(tile.width, tile.height);
+            perturbation->setView(view);
+            calculator = std::move(perturbation);
+        }
+        else if (engineType == EngineType::DOUBLEDOUBLE)
+        {
+            calculator = std::make_unique<DoubleDoubleMandelbrotCalculator>(tile.width, tile.height);
+        }
+        else if (engineType == EngineType::PARALLEL_BORDER)
+        {
+            calculator = std::make_unique<ParallelBorderMandelbrotCalculator>(tile.width, tile.height);
+        }
+        else if (engineType == EngineType::MARIANI_SILVER)
+        {
+            calculator = std::make_unique<MarianiSilverMandelbrotCalculator>(tile.width, tile.height);
+        }
+        else if (engineType == EngineType::REFINEMENT)
+        {
+            calculator = std::make_unique<SuccessiveRefinementMandelbrotCalculator>(tile.width, tile.height);
+        }
         else if (engineType == EngineType::GPUF)
         {
             // For GPU, we only want ONE calculator, not a grid.
@@ -92,56 +180,44 @@ void GridMandelbrotCalculator::updateBounds(double new_cre, double new_cim, doub
             calculator = std::make_unique<BorderMandelbrotCalculator>(tile.width, tile.height);
         }
 
-        // Set explicit bounds for this tile (no aspect ratio adjustment)
-        calculator->updateBoundsExplicit(tile.minR, tile.minI, tile.maxR, tile.maxI);
+        // Set bounds for this tile (no aspect ratio adjustment). All tiles share the
+        // reference point of the grid, tile bounds are offsets from it.
+        calculator->updateBoundsRelative(refr, refi, tile.minR, tile.minI, tile.maxR, tile.maxI);
         calculator->setSpeedMode(speedMode);
+        calculator->setMaxIter(maxIter);
+        calculator->setPeriodicityCheck(periodicityCheck);
+        calculator->setDerivativeCheck(derivativeCheck);
 
         tiles.push_back(std::move(calculator));
     }
 }
 
-void GridMandelbrotCalculator::updateBoundsExplicit(double new_minr, double new_mini, double new_maxr, double new_maxi)
+void GridMandelbrotCalculator::updateBounds(double new_cre, double new_cim, double new_diam)
 {
-    ZoomMandelbrotCalculator::updateBoundsExplicit(new_minr, new_mini, new_maxr, new_maxi);
+    ZoomMandelbrotCalculator::updateBounds(new_cre, new_cim, new_diam);
 
     // Calculate geometry for all tiles
     calculateTileGeometry();
+    createTiles();
+}
 
-    // (Re)create tile calculators with correct dimensions
-    tiles.clear();
-    for (int i = 0; i < gridRows * gridCols; ++i)
-    {
-        const TileInfo &tile = tileInfos[i];
-        std::unique_ptr<MandelbrotCalculator> calculator;
+void GridMandelbrotCalculator::updateBoundsExplicit(double new_minr, double new_mini, double new_maxr, double new_maxi)
+{
+    ZoomMandelbrotCalculator::updateBoundsExplicit(new_minr, new_mini, new_maxr, new_maxi);
 
-        if (engineType == EngineType::STANDARD)
-        {
-         //   calculator = std::make_unique<StandardMandelbrotCalculator>(tile.width, tile.height);
-          calculator = std::make_unique<StandardNewtonCalculator>(tile.width, tile.height);
-        }
-        else if (engineType == EngineType::SIMD)
-        {
-            calculator = std::make_unique<SimdMandelbrotCalculator>(tile.width, tile.height);
-        }
-        else if (engineType == EngineType::GPUF)
-        {
-            calculator = std::make_unique<GpuMandelbrotCalculator>(tile.width, tile.height, GpuMandelbrotCalculator::Precision::FLOAT);
-        }
-        else if (engineType == EngineType::GPUD)
-        {
-            calculator = std::make_unique<GpuMandelbrotCalculator>(tile.width, tile.height, GpuMandelbrotCalculator::Precision::DOUBLE);
-        }
-        else
-        {
-            calculator = std::make_unique<BorderMandelbrotCalculator>(tile.width, tile.height);
-        }
+    // Calculate geometry for all tiles
+    calculateTileGeometry();
+    createTiles();
+}
 
-        // Set explicit bounds for this tile (no aspect ratio adjustment)
-        calculator->updateBoundsExplicit(tile.minR, tile.minI, tile.maxR, tile.maxI);
-        calculator->setSpeedMode(speedMode);
+void GridMandelbrotCalculator::updateBoundsRelative(const HighPrecision &refR, const HighPrecision &refI,
+                                                    FloatExp new_minr, FloatExp new_mini, FloatExp new_maxr, FloatExp new_maxi)
+{
+    ZoomMandelbrotCalculator::updateBoundsRelative(refR, refI, new_minr, new_mini, new_maxr, new_maxi);
 
-        tiles.push_back(std::move(calculator));
-    }
+    // Calculate geometry for all tiles
+    calculateTileGeometry();
+    createTiles();
 }
 
 void GridMandelbrotCalculator::reset()
@@ -162,29 +238,60 @@ void GridMandelbrotCalculator::setSpeedMode(bool mode)
     }
 }
 
-void GridMandelbrotCalculator::compositeData()
+void GridMandelbrotCalculator::setMaxIter(int newMaxIter)
 {
-    // Copy data from all tiles into the unified buffer
-    for (int tileIdx = 0; tileIdx < gridRows * gridCols; ++tileIdx)
+    if (newMaxIter == maxIter)
+        return;
+    ZoomMandelbrotCalculator::setMaxIter(newMaxIter);
+    // Recreated rather than forwarded: a perturbation view is built for one budget
+    createTiles();
+}
+
+void GridMandelbrotCalculator::setPeriodicityCheck(bool enabled)
+{
+    ZoomMandelbrotCalculator::setPeriodicityCheck(enabled);
+    for (auto &tile : tiles)
     {
-        const TileInfo &tile = tileInfos[tileIdx];
-        const auto &tileData = tiles[tileIdx]->getData();
+        tile->setPeriodicityCheck(enabled);
+    }
+}
 
-        // Copy each row of the tile into the unified buffer
-        for (int y = 0; y < tile.height; ++y)
-        {
-            int srcOffset = y * tile.width;
-            int dstOffset = (tile.startY + y) * width + tile.startX;
+void GridMandelbrotCalculator::setDerivativeCheck(bool enabled)
+{
+    ZoomMandelbrotCalculator::setDerivativeCheck(enabled);
+    for (auto &tile : tiles)
+    {
+        tile->setDerivativeCheck(enabled);
+    }
+}
 
-            for (int x = 0; x < tile.width; ++x)
-            {
-             
-                data[dstOffset + x] = tileData[srcOffset + x];
-            }
-        }
+void GridMandelbrotCalculator::compositeTile(int tileIdx)
+{
+    const TileInfo &tile = tileInfos[tileIdx];
+    const auto &tileData = tiles[tileIdx]->getData();
+
+    // Copy each row of the tile into the unified buffer
+    for (int y = 0; y < tile.height; ++y)
+    {
+        int row = tile.startY + y;
+        const int *src = tileData.data() + y * tile.width;
+        std::copy_n(src, tile.width, data.data() + row * width + tile.startX);
+
+        // And into its conjugate row when that one is not computed. Plain
+        // contiguous copies, which compile to a vectorized memmove.
+        int mirror = mirrorSum - row;
+        if (mirrorSum >= 0 && mirror >= 0 && mirror < height && (mirror < rowBegin || mirror >= rowEnd))
+            std::copy_n(src, tile.width, data.data() + mirror * width + tile.startX);
     }
 }
 
+void GridMandelbrotCalculator::compositeData()
+{
+    // Copy data from all tiles into the unified buffer
+    for (int tileIdx = 0; tileIdx < gridRows * gridCols; ++tileIdx)
+        compositeTile(tileIdx);
+}
+
 void GridMandelbrotCalculator::compute(std::function<void()> progressCallback)
 {
     unsigned long long totalComposites = 0; // Track how many times we composite
@@ -236,19 +343,7 @@ void GridMandelbrotCalculator::compute(std::function<void()> progressCallback)
             tiles[tileIdx]->compute([this, tileIdx, progressCallback, &totalComposites]()
                                     {
                 // Composite only the current tile's data (not all tiles)
-                const TileInfo &tile = tileInfos[tileIdx];
-                const auto &tileData = tiles[tileIdx]->getData();
-                
-                for (int y = 0; y < tile.height; ++y)
-                {
-                    int srcOffset = y * tile.width;
-                    int dstOffset = (tile.startY + y) * width + tile.startX;
-                    
-                    for (int x = 0; x < tile.width; ++x)
-                    {
-                        data[dstOffset + x] = tileData[srcOffset + x];
-                    }
-                }
+                compositeTile(tileIdx);
                 
                 totalComposites++;
                 
@@ -259,19 +354,7 @@ void GridMandelbrotCalculator::compute(std::function<void()> progressCallback)
                 } });
 
             // After tile completes, composite its final state and render once more
-            const TileInfo &tile = tileInfos[tileIdx];
-            const auto &tileData = tiles[tileIdx]->getData();
-            
-            for (int y = 0; y < tile.height; ++y)
-            {
-                int srcOffset = y * tile.width;
-                int dstOffset = (tile.startY + y) * width + tile.startX;
-                
-                for (int x = 0; x < tile.width; ++x)
-                {
-                    data[dstOffset + x] = tileData[srcOffset + x];
-                }
-            }
+            compositeTile(tileIdx);
             
             totalComposites++;
             
@@ -287,22 +370,7 @@ void GridMandelbrotCalculator::compute(std::function<void()> progressCallback)
     // In speed mode, composite all tiles once at the end
     if (speedMode)
     {
-        for (int tileIdx = 0; tileIdx < gridRows * gridCols; ++tileIdx)
-        {
-            const TileInfo &tile = tileInfos[tileIdx];
-            const auto &tileData = tiles[tileIdx]->getData();
-
-            for (int y = 0; y < tile.height; ++y)
-            {
-                int srcOffset = y * tile.width;
-                int dstOffset = (tile.startY + y) * width + tile.startX;
-
-                for (int x = 0; x < tile.width; ++x)
-                {
-                    data[dstOffset + x] = tileData[srcOffset + x];
-                }
-            }
-        }
+        compositeData();
         totalComposites = 1; // Only one composite at the end
     }
 }
@@ -312,11 +380,19 @@ void GridMandelbrotCalculator::setEngineType(EngineType type)
     if (engineType != type)
     {
         engineType = type;
-        // Re-initialize calculators with new type
-        updateBounds(cre, cim, diam);
+        // Re-initialize calculators with new type, which decides on the symmetry
+        calculateTileGeometry();
+        createTiles();
     }
 }
 
+void GridMandelbrotCalculator::setNewtonPolynomial(std::shared_ptr<const NewtonPolynomial> polynomial)
+{
+    newtonPolynomial = std::move(polynomial);
+    if (engineType == EngineType::NEWTON)
+        createTiles();
+}
+
 bool GridMandelbrotCalculator::hasOwnOutput() const
 {
     // No calculator has own output anymore
@@ -328,6 +404,13 @@ void GridMandelbrotCalculator::render()
     // Nothing to do here
 }
 
+FloatExp GridMandelbrotCalculator::getMinDiam() const
+{
+    if (tiles.empty())
+        return ZoomMandelbrotCalculator::getMinDiam();
+    return tiles[0]->getMinDiam();
+}
+
 std::string GridMandelbrotCalculator::getEngineName() const
 {
     if (tiles.empty())
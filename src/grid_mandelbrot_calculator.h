@@ -3,6 +3,7 @@
 #include "storage_mandelbrot_calculator.h"
 #include "border_mandelbrot_calculator.h"
 #include "standard_mandelbrot_calculator.h"
+#include "newton_polynomial.h"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -14,8 +15,15 @@ public:
     enum class EngineType
     {
         BORDER,
+        PARALLEL_BORDER, // One image traced by all cores, not split in tiles
+        MARIANI_SILVER,  // Rectangle subdivision, parallel over its own task pool
+        REFINEMENT,      // Coarse-to-fine levels with solid guessing
         STANDARD,
         SIMD,
+        DISTANCE_ESTIMATOR, // Distance estimate shading, disks around known points filled
+        NEWTON, // Newton fractal of a polynomial, vectorized batches
+        PERTURBATION, // Double deltas around a high-precision reference orbit
+        DOUBLEDOUBLE, // Direct iteration in double-double
         GPUF, // GPU with float precision
         GPUD  // GPU with double precision
     };
@@ -24,15 +32,23 @@ public:
 
     void updateBounds(double cre, double cim, double diam) override;
     void updateBoundsExplicit(double minR, double minI, double maxR, double maxI) override;
+    void updateBoundsRelative(const HighPrecision &refR, const HighPrecision &refI,
+                              FloatExp minR, FloatExp minI, FloatExp maxR, FloatExp maxI) override;
     void compute(std::function<void()> progressCallback) override;
     void reset() override;
 
     void setSpeedMode(bool mode) override;
+    void setMaxIter(int maxIter) override;
+    void setPeriodicityCheck(bool enabled) override;
+    void setDerivativeCheck(bool enabled) override;
 
     void setEngineType(EngineType type);
     EngineType getEngineType() const { return engineType; }
+    // Polynomial of the Newton engine, z^3 - 1 when null
+    void setNewtonPolynomial(std::shared_ptr<const NewtonPolynomial> polynomial);
     
     std::string getEngineName() const override;
+    FloatExp getMinDiam() const override;
 
     // Override to handle GPU pass-through
     bool hasOwnOutput() const override;
@@ -43,6 +59,7 @@ private:
     int gridCols;
 
     EngineType engineType;
+    std::shared_ptr<const NewtonPolynomial> newtonPolynomial;
 
     std::vector<std::unique_ptr<MandelbrotCalculator>> tiles;
 
@@ -51,11 +68,21 @@ private:
     {
         int startX, startY; // Starting pixel position
         int width, height;  // Tile dimensions in pixels
-        double minR, minI;  // Complex plane bounds
-        double maxR, maxI;
+        FloatExp minR, minI; // Complex plane bounds, relative to the reference point
+        FloatExp maxR, maxI;
     };
     std::vector<TileInfo> tileInfos;
 
+    // Real-axis symmetry: rows y and mirrorSum - y sample conjugate points, which
+    // have the same iteration count. When the view straddles the axis the tiles
+    // only cover rows [rowBegin, rowEnd), the rows mirrored outside of it are
+    // copied. mirrorSum is -1 when nothing is mirrored.
+    int mirrorSum;
+    int rowBegin, rowEnd;
+
+    void findMirrorRows();
     void calculateTileGeometry();
+    void createTiles();
+    void compositeTile(int tileIdx);
     void compositeData();
 };
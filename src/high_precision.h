@@ -0,0 +1,9 @@
+#pragma once
+
+#include "big_fixed.h"
+
+// Number type of the high-precision view coordinates (center of the view and
+// reference point of the perturbation engine). Fixed point with as many limbs
+// as the coordinates need, so the depth is limited by the double pixel step
+// rather than by the coordinates.
+using HighPrecision = BigFixed;
@@ -0,0 +1,24 @@
+#pragma once
+
+// Closed-form interior tests for the two largest components of the set.
+// Points inside the main cardioid or the period-2 bulb never escape, so the
+// engines report maxIter for them without iterating. These are the most
+// expensive pixels of the home view.
+// Declared static so every translation unit, including the ISA-specific SIMD
+// kernels, keeps its own copy compiled with its own flags.
+template <class T>
+static inline bool isInMainCardioidOrBulb(T x, T y)
+{
+    T y2 = y * y;
+
+    // Main cardioid: q * (q + (x - 1/4)) <= y^2 / 4 with q = (x - 1/4)^2 + y^2
+    T xq = x - T(0.25);
+    T q = xq * xq + y2;
+    bool cardioid = q * (q + xq) <= T(0.25) * y2;
+
+    // Period-2 bulb: disk of radius 1/4 centered on -1
+    T xb = x + T(1);
+    bool bulb = xb * xb + y2 <= T(0.0625);
+
+    return cardioid | bulb;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Image size from which the fill runs its rows on all cores. Grid tiles stay below
+// it, they already run one per thread.
+static constexpr int PARALLEL_FILL_PIXELS = 1 << 20;
+
+// Last pass of the boundary tracing engines: every pixel the tracing did not load
+// lies inside a traced contour, so it takes the value of the loaded pixel to its
+// left on the same row. Rows are independent and never read across the right edge
+// into the next row; large images split them between threads.
+template <class IsLoaded>
+void fillUntracedPixels(int *data, int width, int height, IsLoaded isLoaded)
+{
+    auto fillRows = [=](int begin, int end)
+    {
+        for (int y = begin; y < end; ++y)
+        {
+            int *row = data + y * width;
+            unsigned p = y * width;
+            // The screen edges are always traced, x = 0 is loaded
+            int last = row[0];
+            for (int x = 0; x < width; ++x, ++p)
+            {
+                if (isLoaded(p))
+                    last = row[x];
+                else
+                    row[x] = last;
+            }
+        }
+    };
+
+    unsigned numThreads = 1;
+    if (width * height >= PARALLEL_FILL_PIXELS)
+        numThreads = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(), height));
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; ++t)
+        threads.emplace_back(fillRows, height * t / numThreads, height * (t + 1) / numThreads);
+    fillRows(0, height / numThreads);
+    for (auto &thread : threads)
+        thread.join();
+}
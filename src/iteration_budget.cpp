@@ -0,0 +1,48 @@
+#include "iteration_budget.h"
+#include <algorithm>
+#include <cmath>
+
+// Share of all pixels escaping in the last quarter of the budget above which it is raised
+static constexpr double LATE_ESCAPE_SHARE = 0.005;
+// Share of black pixels above which a frame counts as mostly black
+static constexpr double BLACK_SHARE = 0.5;
+// Budget a mostly black frame may grow to, per decade of zoom below the full set
+static constexpr double ITER_PER_DECADE = 512.0;
+
+int IterationBudget::adapt(const std::vector<int> &data, int maxIter, const FloatExp &diam)
+{
+    const int lateFrom = maxIter - maxIter / 4;
+    long black = 0;
+    long late = 0;
+    int highest = 0;
+
+    for (int iter : data)
+    {
+        if (iter >= maxIter)
+        {
+            ++black;
+            continue;
+        }
+        if (iter >= lateFrom)
+            ++late;
+        highest = std::max(highest, iter);
+    }
+
+    const double pixels = static_cast<double>(data.size());
+    // Decades below the full set, from log2 so that it holds past the double range
+    const double decades = (std::log2(3.0) - diam.log2()) * std::log10(2.0);
+    const double depthBudget = ITER_PER_DECADE * decades;
+
+    const bool mostlyBlack = black > BLACK_SHARE * pixels;
+
+    if (late > LATE_ESCAPE_SHARE * pixels || (mostlyBlack && maxIter < depthBudget))
+        return std::min(maxIter * 2, MAX_MAX_ITER);
+
+    // Halving keeps the budget at least twice the slowest escape, so the frame is unchanged.
+    // That includes its black share: a mostly black frame keeps a budget of at least
+    // depthBudget, otherwise the next frame would raise it right back.
+    if (black < pixels && highest < maxIter / 4 && !(mostlyBlack && maxIter / 2 < depthBudget))
+        return std::max(maxIter / 2, MIN_MAX_ITER);
+
+    return maxIter;
+}
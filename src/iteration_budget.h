@@ -0,0 +1,24 @@
+#pragma once
+
+#include "float_exp.h"
+#include <vector>
+
+// Adaptive iteration budget, driven by the escape counts of the last frame:
+// - a noticeable share of pixels escaping in the last quarter of the budget means
+//   it cut off pixels that were still on their way out: raise it
+// - a mostly black frame is either true interior or a budget far too small for
+//   the depth: raise it while it is below what the zoom depth usually needs
+// - nothing escaping past the first quarter means every interior pixel pays for
+//   iterations that change nothing: lower it, but not below the depth budget on a
+//   mostly black frame, which would only be raised again
+// The budget moves by factors of two, so it follows the zoom within a few frames.
+class IterationBudget
+{
+public:
+    static constexpr int MIN_MAX_ITER = 256;
+    // Largest count the GPU engines read back (16-bit encoding)
+    static constexpr int MAX_MAX_ITER = 65535;
+
+    // Budget for the next frame of a view of size diam rendered with maxIter
+    static int adapt(const std::vector<int> &data, int maxIter, const FloatExp &diam);
+};
@@ -1,6 +1,8 @@
 #include "mandelbrot_app.h"
+#include "iteration_budget.h"
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
 
 int main(int argc, char *argv[])
 {
@@ -12,8 +14,12 @@ int main(int argc, char *argv[])
         bool verboseMode = false;
         bool autoZoom = false;
         bool randomPalette = false;
+        bool periodicity = false;
+        bool derivative = false;
+        int maxIter = MandelbrotCalculator::DEFAULT_MAX_ITER; // 0 = adaptive
         int pixelSize = 1;
         std::string engineType = "border"; // default to border tracing
+        std::shared_ptr<const NewtonPolynomial> newtonPolynomial; // z^3 - 1 unless given
 
         for (int i = 1; i < argc; ++i)
         {
@@ -37,6 +43,54 @@ int main(int argc, char *argv[])
             {
                 randomPalette = true;
             }
+            else if (strcmp(argv[i], "--periodicity") == 0)
+            {
+                periodicity = true;
+            }
+            else if (strcmp(argv[i], "--derivative") == 0)
+            {
+                derivative = true;
+            }
+            else if (strcmp(argv[i], "--max-iter") == 0)
+            {
+                if (i + 1 < argc)
+                {
+                    const char *value = argv[++i];
+                    long count = strcmp(value, "auto") == 0 ? 0 : std::strtol(value, nullptr, 10);
+                    if (count < 0 || (count == 0 && strcmp(value, "auto") != 0))
+                    {
+                        std::cerr << "Error: --max-iter requires a positive count or auto" << std::endl;
+                        return 1;
+                    }
+                    // The GPU engines read the counts back as 16 bits
+                    if (count > IterationBudget::MAX_MAX_ITER)
+                    {
+                        std::cerr << "Error: --max-iter is at most " << IterationBudget::MAX_MAX_ITER << std::endl;
+                        return 1;
+                    }
+                    maxIter = static_cast<int>(count);
+                }
+                else
+                {
+                    std::cerr << "Error: --max-iter requires an argument (count or auto)" << std::endl;
+                    return 1;
+                }
+            }
+            else if (strcmp(argv[i], "--poly") == 0 || strcmp(argv[i], "--poly-file") == 0)
+            {
+                if (i + 1 < argc)
+                {
+                    const bool file = strcmp(argv[i], "--poly-file") == 0;
+                    const char *value = argv[++i];
+                    newtonPolynomial = std::make_shared<const NewtonPolynomial>(
+                        file ? NewtonPolynomial::load(value) : NewtonPolynomial::parse(value));
+                }
+                else
+                {
+                    std::cerr << "Error: " << argv[i] << " requires an argument (polynomial or file)" << std::endl;
+                    return 1;
+                }
+            }
             else if (strcmp(argv[i], "--pixel-size") == 0)
             {
                 if (i + 1 < argc)
@@ -59,7 +113,7 @@ int main(int argc, char *argv[])
                 }
                 else
                 {
-                    std::cerr << "Error: --engine requires an argument (border|standard|simd|gpuf|gpud)" << std::endl;
+                    std::cerr << "Error: --engine requires an argument (border|pborder|msilver|refine|standard|simd|de|newton|perturbation|dd|gpuf|gpud)" << std::endl;
                     return 1;
                 }
             }
@@ -71,11 +125,23 @@ int main(int argc, char *argv[])
                 std::cout << "  --fast, -f, --speed, -s    Enable fast mode (parallel 4x4 grid)" << std::endl;
                 std::cout << "  --engine <type>            Set computation engine:" << std::endl;
                 std::cout << "                             border   = Boundary tracing (default, fastest)" << std::endl;
+                std::cout << "                             pborder  = Boundary tracing of one image on all cores" << std::endl;
+                std::cout << "                             msilver  = Mariani-Silver rectangle subdivision" << std::endl;
+                std::cout << "                             refine   = Successive refinement, coarse preview first" << std::endl;
                 std::cout << "                             standard = Standard pixel-by-pixel" << std::endl;
                 std::cout << "                             simd     = SIMD optimized" << std::endl;
+                std::cout << "                             de       = Distance estimate shading, skips disks known to be outside" << std::endl;
+                std::cout << "                             newton   = Newton fractal of a polynomial (z^3 - 1 by default), vectorized" << std::endl;
+                std::cout << "                             perturbation = Deep zoom past 1e-15 (down to 1e-1000)" << std::endl;
+                std::cout << "                             dd       = Double-double, deep zoom to 1e-25" << std::endl;
                 std::cout << "                             gpuf     = GPU float precision (~50ms)" << std::endl;
                 std::cout << "                             gpud     = GPU double precision (~550ms)" << std::endl;
+                std::cout << "  --poly <polynomial>        Polynomial of the newton engine, e.g. \"z^8+15z^4-16\"" << std::endl;
+                std::cout << "  --poly-file <path>         Same, read from the first line of a file" << std::endl;
                 std::cout << "  --pixel-size <1-20>        Set pixel size (1=normal, 10=blocky)" << std::endl;
+                std::cout << "  --periodicity              Stop interior orbits early (cycle detection)" << std::endl;
+                std::cout << "  --derivative               Stop interior orbits early (shrinking dz/dz0), sooner than --periodicity" << std::endl;
+                std::cout << "  --max-iter <N|auto>        Iteration budget (default 768, at most 65535), auto adapts it to the zoom" << std::endl;
                 std::cout << "  --random-palette, -p       Start with random color palette" << std::endl;
                 std::cout << "  --auto-zoom, -a            Enable automatic zooming" << std::endl;
                 std::cout << "  --verbose, -v              Enable verbose output (timing info)" << std::endl;
@@ -88,7 +154,7 @@ int main(int argc, char *argv[])
                 std::cout << "  F        - Toggle fast mode (parallel computation)" << std::endl;
                 std::cout << "  S        - Save screenshot" << std::endl;
                 std::cout << "  Shift+S  - Toggle auto-screenshot mode" << std::endl;
-                std::cout << "  E        - Cycle engine (Border→Standard→SIMD→GPU-Float→GPU-Double)" << std::endl;
+                std::cout << "  E        - Cycle engine (" << MandelbrotApp::engineCycleDescription() << ")" << std::endl;
                 std::cout << "  P        - Random palette" << std::endl;
                 std::cout << "  V        - Toggle verbose mode" << std::endl;
                 std::cout << "  A        - Toggle auto-zoom" << std::endl;
@@ -126,6 +192,26 @@ int main(int argc, char *argv[])
             app.setRandomPalette();
         }
 
+        if (periodicity)
+        {
+            app.setPeriodicityCheck(true);
+        }
+
+        if (derivative)
+        {
+            app.setDerivativeCheck(true);
+        }
+
+        if (maxIter != MandelbrotCalculator::DEFAULT_MAX_ITER)
+        {
+            app.setMaxIter(maxIter);
+        }
+
+        if (newtonPolynomial)
+        {
+            app.setNewtonPolynomial(newtonPolynomial);
+        }
+
         if (pixelSize != 1)
         {
             app.setPixelSize(pixelSize);
@@ -13,25 +13,85 @@
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
+#include "iteration_budget.h"
 
 // Define this to get modern OpenGL functions
 #define GL_GLEXT_PROTOTYPES
 #include <SDL2/SDL_opengl.h>
 
+namespace {
+// Engines in the order the E key cycles through them, with their help names
+struct EngineCycleEntry {
+  GridMandelbrotCalculator::EngineType type;
+  const char *name;
+};
+
+constexpr EngineCycleEntry ENGINE_CYCLE[] = {
+    {GridMandelbrotCalculator::EngineType::BORDER, "Border"},
+    {GridMandelbrotCalculator::EngineType::PARALLEL_BORDER, "Parallel-Border"},
+    {GridMandelbrotCalculator::EngineType::MARIANI_SILVER, "Mariani-Silver"},
+    {GridMandelbrotCalculator::EngineType::REFINEMENT, "Refinement"},
+    {GridMandelbrotCalculator::EngineType::STANDARD, "Standard"},
+    {GridMandelbrotCalculator::EngineType::SIMD, "SIMD"},
+    {GridMandelbrotCalculator::EngineType::DISTANCE_ESTIMATOR, "Distance"},
+    {GridMandelbrotCalculator::EngineType::NEWTON, "Newton"},
+    {GridMandelbrotCalculator::EngineType::PERTURBATION, "Perturbation"},
+    {GridMandelbrotCalculator::EngineType::DOUBLEDOUBLE, "Double-Double"},
+    {GridMandelbrotCalculator::EngineType::GPUF, "GPU-Float"},
+    {GridMandelbrotCalculator::EngineType::GPUD, "GPU-Double"},
+};
+
+// Scientific notation for view sizes below the double range
+std::string formatDiam(const FloatExp &diam) {
+  if (diam.toDouble() != 0.0)
+    return std::format("{:.2e}", diam.toDouble());
+  double decimal = diam.log2() * std::log10(2.0);
+  double exponent = std::floor(decimal);
+  return std::format("{:.2f}e{:+03.0f}", std::pow(10.0, decimal - exponent),
+                     exponent);
+}
+} // namespace
+
+std::string MandelbrotApp::engineCycleDescription() {
+  std::string description;
+  for (const EngineCycleEntry &entry : ENGINE_CYCLE) {
+    if (!description.empty())
+      description += "→";
+    description += entry.name;
+  }
+  return description;
+}
+
 MandelbrotApp::MandelbrotApp(int w, int h, bool speed,
                              const std::string &engineType)
     : width(w), height(h), pixelSize(1), window(nullptr), renderer(nullptr),
       texture(nullptr), glContext(nullptr), ownsGLContext(false),
       autoZoomActive(false), speedMode(speed), verboseMode(false),
       exitAfterFirstDisplay(false), autoScreenshotMode(false),
+      periodicityCheck(false), derivativeCheck(false),
+      maxIter(MandelbrotCalculator::DEFAULT_MAX_ITER), adaptiveMaxIter(false),
       currentEngineType(GridMandelbrotCalculator::EngineType::BORDER) {
   // Parse engine type
   if (engineType == "border") {
     currentEngineType = GridMandelbrotCalculator::EngineType::BORDER;
+  } else if (engineType == "pborder" || engineType == "parallel") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::PARALLEL_BORDER;
+  } else if (engineType == "msilver" || engineType == "mariani") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::MARIANI_SILVER;
+  } else if (engineType == "refine" || engineType == "refinement") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::REFINEMENT;
   } else if (engineType == "standard") {
     currentEngineType = GridMandelbrotCalculator::EngineType::STANDARD;
   } else if (engineType == "simd") {
     currentEngineType = GridMandelbrotCalculator::EngineType::SIMD;
+  } else if (engineType == "de" || engineType == "distance") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::DISTANCE_ESTIMATOR;
+  } else if (engineType == "newton") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::NEWTON;
+  } else if (engineType == "perturbation" || engineType == "pert") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::PERTURBATION;
+  } else if (engineType == "doubledouble" || engineType == "dd") {
+    currentEngineType = GridMandelbrotCalculator::EngineType::DOUBLEDOUBLE;
   } else if (engineType == "gpuf" || engineType == "gpu") {
     currentEngineType = GridMandelbrotCalculator::EngineType::GPUF;
   } else if (engineType == "gpud") {
@@ -95,30 +155,7 @@ MandelbrotApp::MandelbrotApp(int w, int h, bool speed,
                              SDL_GetError());
   }
 
-  // Speed mode: 4x4 grid with parallel computation
-  // Normal mode: 1x1 grid (effectively single calculator) with progressive
-  // rendering
-  if (currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
-      currentEngineType == GridMandelbrotCalculator::EngineType::GPUD) {
-    // GPU always uses 1x1 grid
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 1, 1);
-    gridCalc->setSpeedMode(speedMode);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  } else if (speedMode) {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 4, 4);
-    gridCalc->setSpeedMode(true);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  } else {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 1, 1);
-    gridCalc->setSpeedMode(false);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  }
+  createCalculator();
 
   zoomChooser = std::make_unique<ZoomPointChooser>(calcWidth, calcHeight);
 
@@ -172,6 +209,30 @@ void MandelbrotApp::initSDL() {
 // Removed switchToOpenGL and switchToSDLRenderer as we now use a unified
 // approach
 
+void MandelbrotApp::createCalculator() {
+  // Speed mode: 4x4 grid with parallel computation
+  // Normal mode: 1x1 grid (effectively single calculator) with progressive
+  // rendering. GPU always uses a 1x1 grid, and so do the parallel border and
+  // Mariani-Silver engines, which spread one image over all cores themselves.
+  bool gpu = currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
+             currentEngineType == GridMandelbrotCalculator::EngineType::GPUD;
+  bool parallel =
+      currentEngineType ==
+          GridMandelbrotCalculator::EngineType::PARALLEL_BORDER ||
+      currentEngineType == GridMandelbrotCalculator::EngineType::MARIANI_SILVER;
+  int gridSize = (speedMode && !gpu && !parallel) ? 4 : 1;
+
+  auto gridCalc = std::make_unique<GridMandelbrotCalculator>(
+      calcWidth, calcHeight, gridSize, gridSize);
+  gridCalc->setSpeedMode(speedMode);
+  gridCalc->setPeriodicityCheck(periodicityCheck);
+  gridCalc->setDerivativeCheck(derivativeCheck);
+  gridCalc->setMaxIter(maxIter);
+  gridCalc->setNewtonPolynomial(newtonPolynomial);
+  gridCalc->setEngineType(currentEngineType);
+  calculator = std::move(gridCalc);
+}
+
 void MandelbrotApp::compute() {
   // For GPU mode, ensure OpenGL context is current
   if ((currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
@@ -182,8 +243,20 @@ void MandelbrotApp::compute() {
 
   auto startTime = std::chrono::high_resolution_clock::now();
 
+  calculator->setMaxIter(maxIter);
   calculator->compute([this]() { this->render(); });
 
+  if (adaptiveMaxIter) {
+    // A budget that was too small shows as black blobs: raise it and redo the
+    // frame right away. A lower budget only takes effect on the next frame.
+    maxIter = IterationBudget::adapt(calculator->getData(), maxIter, calculator->getDiamFE());
+    while (maxIter > calculator->getMaxIter()) {
+      calculator->setMaxIter(maxIter);
+      calculator->compute([this]() { this->render(); });
+      maxIter = IterationBudget::adapt(calculator->getData(), maxIter, calculator->getDiamFE());
+    }
+  }
+
   if (verboseMode) {
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -193,10 +266,10 @@ void MandelbrotApp::compute() {
     std::string engineName = calculator->getEngineName();
 
     std::cout << std::format(
-        "{} {:>4}x{:<4} {:>8.1f} ms  {:>20.16f} {:>20.16f} {:>12.2e}\n",
+        "{} {:>4}x{:<4} {:>8.1f} ms  {:>20.16f} {:>20.16f} {:>12}\n",
         engineName, calculator->getWidth(), calculator->getHeight(),
         milliseconds, calculator->getCre(), calculator->getCim(),
-        calculator->getDiam());
+        formatDiam(calculator->getDiamFE()));
   }
 }
 
@@ -214,15 +287,16 @@ void MandelbrotApp::render() {
   SDL_LockTexture(texture, nullptr, (void **)&pixels, &pitch);
 
   const auto &data = calculator->getData();
+  const int budget = calculator->getMaxIter();
 
   for (int y = 0; y < calcHeight; ++y) {
     for (int x = 0; x < calcWidth; ++x) {
       int p = y * calcWidth + x;
       int iter = data[p];
-      if (iter == MandelbrotCalculator::MAX_ITER) {
+      if (iter == budget) {
         pixels[y * (pitch / 4) + x] = 0xFF000000; // Black (Alpha=255)
       } else {
-        double t = static_cast<double>(iter) / MandelbrotCalculator::MAX_ITER;
+        double t = static_cast<double>(iter) / budget;
         SDL_Color color = gradient->getColor(t);
 
         if (iter % 2 != 0) {
@@ -299,7 +373,7 @@ SDL_Rect MandelbrotApp::calculateSelectionRect(int startX, int startY, int endX,
 void MandelbrotApp::resetZoom() { calculator->updateBounds(-0.5, 0.0, 3.0); }
 
 bool MandelbrotApp::isZoomDisabled() const {
-  return calculator->getDiam() < 1e-15;
+  return calculator->getDiamFE() < calculator->getMinDiam();
 }
 
 void MandelbrotApp::setPixelSize(int newSize) {
@@ -307,36 +381,17 @@ void MandelbrotApp::setPixelSize(int newSize) {
     return;
 
   // Save current view parameters
-  double currentCre = calculator->getCre();
-  double currentCim = calculator->getCim();
-  double currentDiam = calculator->getDiam();
+  HighPrecision currentCre = calculator->getCreHP();
+  HighPrecision currentCim = calculator->getCimHP();
+  FloatExp currentDiam = calculator->getDiamFE();
 
   pixelSize = newSize;
   calcWidth = width / pixelSize;
   calcHeight = height / pixelSize;
 
   // Recreate calculator with appropriate grid size based on speed mode
-  if (currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
-      currentEngineType == GridMandelbrotCalculator::EngineType::GPUD) {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 1, 1);
-    gridCalc->setSpeedMode(speedMode);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  } else if (speedMode) {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 4, 4);
-    gridCalc->setSpeedMode(true);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  } else {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 1, 1);
-    gridCalc->setSpeedMode(false);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  }
-  calculator->updateBounds(currentCre, currentCim, currentDiam);
+  createCalculator();
+  calculator->updateBoundsHP(currentCre, currentCim, currentDiam);
 
   zoomChooser = std::make_unique<ZoomPointChooser>(calcWidth, calcHeight);
 
@@ -365,9 +420,9 @@ void MandelbrotApp::handleResize(int newWidth, int newHeight) {
     return;
 
   // Save current view parameters
-  double currentCre = calculator->getCre();
-  double currentCim = calculator->getCim();
-  double currentDiam = calculator->getDiam();
+  HighPrecision currentCre = calculator->getCreHP();
+  HighPrecision currentCim = calculator->getCimHP();
+  FloatExp currentDiam = calculator->getDiamFE();
 
   // Update dimensions
   width = newWidth;
@@ -376,27 +431,8 @@ void MandelbrotApp::handleResize(int newWidth, int newHeight) {
   calcHeight = height / pixelSize;
 
   // Recreate calculator with appropriate grid size based on speed mode
-  if (currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
-      currentEngineType == GridMandelbrotCalculator::EngineType::GPUD) {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 1, 1);
-    gridCalc->setSpeedMode(speedMode);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  } else if (speedMode) {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 4, 4);
-    gridCalc->setSpeedMode(true);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  } else {
-    auto gridCalc =
-        std::make_unique<GridMandelbrotCalculator>(calcWidth, calcHeight, 1, 1);
-    gridCalc->setSpeedMode(false);
-    gridCalc->setEngineType(currentEngineType);
-    calculator = std::move(gridCalc);
-  }
-  calculator->updateBounds(currentCre, currentCim, currentDiam);
+  createCalculator();
+  calculator->updateBoundsHP(currentCre, currentCim, currentDiam);
 
   // Recreate zoom chooser
   zoomChooser = std::make_unique<ZoomPointChooser>(calcWidth, calcHeight);
@@ -431,23 +467,24 @@ void MandelbrotApp::zoomToRegion(int x1, int y1, int x2, int y2) {
   if (y1 > y2)
     std::swap(y1, y2);
 
-  // Convert pixel coordinates to complex plane
-  double minr = calculator->getMinR();
-  double mini = calculator->getMinI();
-  double stepr = calculator->getStepR();
-  double stepi = calculator->getStepI();
+  // Convert pixel coordinates to offsets from the view center, so the new
+  // center keeps its full precision on deep zooms
+  FloatExp spanR = calculator->getStepRFE() * FloatExp(calcWidth);
+  FloatExp spanI = calculator->getStepIFE() * FloatExp(calcHeight);
 
   // Adjust for resolution difference between window and calculation
-  double re1 = minr + (x1 / (double)width) * (stepr * calcWidth);
-  double im1 = mini + (y1 / (double)height) * (stepi * calcHeight);
-  double re2 = minr + (x2 / (double)width) * (stepr * calcWidth);
-  double im2 = mini + (y2 / (double)height) * (stepi * calcHeight);
-
-  double new_cre = (re1 + re2) / 2.0;
-  double new_cim = (im1 + im2) / 2.0;
-  double new_diam = std::max(re2 - re1, im2 - im1);
-
-  calculator->updateBounds(new_cre, new_cim, new_diam);
+  FloatExp re1 = FloatExp(x1 / (double)width - 0.5) * spanR;
+  FloatExp im1 = FloatExp(y1 / (double)height - 0.5) * spanI;
+  FloatExp re2 = FloatExp(x2 / (double)width - 0.5) * spanR;
+  FloatExp im2 = FloatExp(y2 / (double)height - 0.5) * spanI;
+
+  HighPrecision new_cre =
+      calculator->getCreHP() + HighPrecision((re1 + re2) * FloatExp(0.5));
+  HighPrecision new_cim =
+      calculator->getCimHP() + HighPrecision((im1 + im2) * FloatExp(0.5));
+  FloatExp new_diam = std::max(re2 - re1, im2 - im1);
+
+  calculator->updateBoundsHP(new_cre, new_cim, new_diam);
 }
 void MandelbrotApp::animateRectToRect(int startX, int startY, int startWidth,
                                       int startHeight, int endX, int endY,
@@ -520,15 +557,17 @@ void MandelbrotApp::zoomToRect(int x1, int y1, int x2, int y2, bool inverse) {
     int offsetY = (y1 + y2) / 2 - height / 2;
 
     // Adjust step size for resolution difference
-    double effectiveStepR =
-        calculator->getStepR() * ((double)calcWidth / width);
-    double effectiveStepI =
-        calculator->getStepI() * ((double)calcHeight / height);
-
-    double new_cre = calculator->getCre() + offsetX * effectiveStepR * scale;
-    double new_cim = calculator->getCim() + offsetY * effectiveStepI * scale;
-    double new_diam = calculator->getDiam() * scale;
-    calculator->updateBounds(new_cre, new_cim, new_diam);
+    FloatExp effectiveStepR =
+        calculator->getStepRFE() * FloatExp((double)calcWidth / width);
+    FloatExp effectiveStepI =
+        calculator->getStepIFE() * FloatExp((double)calcHeight / height);
+
+    HighPrecision new_cre =
+        calculator->getCreHP() + HighPrecision(FloatExp(offsetX * scale) * effectiveStepR);
+    HighPrecision new_cim =
+        calculator->getCimHP() + HighPrecision(FloatExp(offsetY * scale) * effectiveStepI);
+    FloatExp new_diam = calculator->getDiamFE() * FloatExp(scale);
+    calculator->updateBoundsHP(new_cre, new_cim, new_diam);
   } else {
     // Zoom IN: animate rectangle expanding to full screen
     animateRectToRect(x1, y1, x2 - x1, y2 - y1, 0, 0, width, height);
@@ -550,8 +589,7 @@ void MandelbrotApp::run() {
               << std::endl;
     std::cout << "  S        - Save screenshot" << std::endl;
     std::cout << "  Shift+S  - Toggle auto-screenshot mode" << std::endl;
-    std::cout << "  E        - Cycle engine "
-                 "(Border→Standard→SIMD→GPU-Float→GPU-Double)"
+    std::cout << "  E        - Cycle engine (" << engineCycleDescription() << ")"
               << std::endl;
     std::cout << "  P        - Random palette" << std::endl;
     std::cout << "  V        - Toggle verbose mode" << std::endl;
@@ -636,83 +674,44 @@ void MandelbrotApp::run() {
           speedMode = !speedMode;
 
           // Save current view parameters
-          double currentCre = calculator->getCre();
-          double currentCim = calculator->getCim();
-          double currentDiam = calculator->getDiam();
+          HighPrecision currentCre = calculator->getCreHP();
+          HighPrecision currentCim = calculator->getCimHP();
+          FloatExp currentDiam = calculator->getDiamFE();
 
           // Recreate calculator with appropriate grid size
+          createCalculator();
           if (currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
               currentEngineType == GridMandelbrotCalculator::EngineType::GPUD) {
-            auto gridCalc = std::make_unique<GridMandelbrotCalculator>(
-                calcWidth, calcHeight, 1, 1);
-            gridCalc->setSpeedMode(speedMode);
-            gridCalc->setEngineType(currentEngineType);
-            calculator = std::move(gridCalc);
             std::cout << "Speed mode: " << (speedMode ? "ON" : "OFF")
                       << " (GPU 1x1)" << std::endl;
-          } else if (speedMode) {
-            auto gridCalc = std::make_unique<GridMandelbrotCalculator>(
-                calcWidth, calcHeight, 4, 4);
-            gridCalc->setSpeedMode(true);
-            gridCalc->setEngineType(currentEngineType);
-            calculator = std::move(gridCalc);
-          } else {
-            auto gridCalc = std::make_unique<GridMandelbrotCalculator>(
-                calcWidth, calcHeight, 1, 1);
-            gridCalc->setSpeedMode(false);
-            gridCalc->setEngineType(currentEngineType);
-            calculator = std::move(gridCalc);
           }
-          calculator->updateBounds(currentCre, currentCim, currentDiam);
+          calculator->updateBoundsHP(currentCre, currentCim, currentDiam);
 
           // Recompute with new calculator
           compute();
           render();
         } else if (event.type == SDL_KEYDOWN &&
                    event.key.keysym.sym == SDLK_e) {
-          // Toggle engine type
-          if (currentEngineType ==
-              GridMandelbrotCalculator::EngineType::BORDER) {
-            currentEngineType = GridMandelbrotCalculator::EngineType::STANDARD;
-          } else if (currentEngineType ==
-                     GridMandelbrotCalculator::EngineType::STANDARD) {
-            currentEngineType = GridMandelbrotCalculator::EngineType::SIMD;
-          } else if (currentEngineType ==
-                     GridMandelbrotCalculator::EngineType::SIMD) {
-            currentEngineType = GridMandelbrotCalculator::EngineType::GPUF;
-          } else if (currentEngineType ==
-                     GridMandelbrotCalculator::EngineType::GPUF) {
-            currentEngineType = GridMandelbrotCalculator::EngineType::GPUD;
-          } else {
-            currentEngineType = GridMandelbrotCalculator::EngineType::BORDER;
-          }
+          // Next engine of the cycle, the first one after the last
+          auto current = std::find_if(
+              std::begin(ENGINE_CYCLE), std::end(ENGINE_CYCLE),
+              [this](const EngineCycleEntry &entry) {
+                return entry.type == currentEngineType;
+              });
+          if (current == std::end(ENGINE_CYCLE) ||
+              ++current == std::end(ENGINE_CYCLE))
+            current = std::begin(ENGINE_CYCLE);
+          currentEngineType = current->type;
 
           // Save current view parameters
-          double currentCre = calculator->getCre();
-          double currentCim = calculator->getCim();
-          double currentDiam = calculator->getDiam();
+          HighPrecision currentCre = calculator->getCreHP();
+          HighPrecision currentCim = calculator->getCimHP();
+          FloatExp currentDiam = calculator->getDiamFE();
 
           // Recreate calculator based on engine type
-          if (currentEngineType == GridMandelbrotCalculator::EngineType::GPUF ||
-              currentEngineType == GridMandelbrotCalculator::EngineType::GPUD) {
-            // GPU mode always uses 1x1 grid - ensure OpenGL context is ready
-            auto gridCalc = std::make_unique<GridMandelbrotCalculator>(
-                calcWidth, calcHeight, 1, 1);
-            gridCalc->setSpeedMode(speedMode);
-            gridCalc->setEngineType(currentEngineType);
-            calculator = std::move(gridCalc);
-          } else {
-            // Restore grid size based on speed mode
-            int rows = speedMode ? 4 : 1;
-            int cols = speedMode ? 4 : 1;
-            auto gridCalc = std::make_unique<GridMandelbrotCalculator>(
-                calcWidth, calcHeight, rows, cols);
-            gridCalc->setSpeedMode(speedMode);
-            gridCalc->setEngineType(currentEngineType);
-            calculator = std::move(gridCalc);
-          }
+          createCalculator();
 
-          calculator->updateBounds(currentCre, currentCim, currentDiam);
+          calculator->updateBoundsHP(currentCre, currentCim, currentDiam);
           compute();
           render();
         } else if (event.type == SDL_KEYDOWN &&
@@ -768,7 +767,7 @@ void MandelbrotApp::run() {
           // Skip zoom-in if disabled (allow zoom-out)
           if (!shiftPressed && isZoomDisabled()) {
             std::cout << "Zoom disabled: diameter too small ("
-                      << calculator->getDiam() << ")" << std::endl;
+                      << formatDiam(calculator->getDiamFE()) << ")" << std::endl;
             break;
           }
 
@@ -846,7 +845,7 @@ void MandelbrotApp::run() {
         // Find an interesting point to zoom to (in calculation coordinates)
         int calcCenterX, calcCenterY;
         zoomChooser->findInterestingPoint(
-            calculator->getData(), MandelbrotCalculator::MAX_ITER, calcCenterX,
+            calculator->getData(), calculator->getMaxIter(), calcCenterX,
             calcCenterY, calcRectW, calcRectH);
 
         // Convert back to window coordinates for display and zooming
@@ -946,4 +945,28 @@ void MandelbrotApp::setVerboseMode(bool verbose) {
 
 void MandelbrotApp::setAutoZoom(bool enabled) { autoZoomActive = enabled; }
 
+void MandelbrotApp::setPeriodicityCheck(bool enabled) {
+  periodicityCheck = enabled;
+  calculator->setPeriodicityCheck(enabled);
+}
+
+void MandelbrotApp::setDerivativeCheck(bool enabled) {
+  derivativeCheck = enabled;
+  calculator->setDerivativeCheck(enabled);
+}
+
+void MandelbrotApp::setMaxIter(int newMaxIter) {
+  adaptiveMaxIter = newMaxIter == 0;
+  maxIter = adaptiveMaxIter ? MandelbrotCalculator::DEFAULT_MAX_ITER
+                            : std::min(newMaxIter, IterationBudget::MAX_MAX_ITER);
+  calculator->setMaxIter(maxIter);
+}
+
+void MandelbrotApp::setNewtonPolynomial(
+    std::shared_ptr<const NewtonPolynomial> polynomial) {
+  newtonPolynomial = polynomial;
+  static_cast<GridMandelbrotCalculator &>(*calculator)
+      .setNewtonPolynomial(std::move(polynomial));
+}
+
 void MandelbrotApp::setRandomPalette() { gradient = Gradient::createRandom(); }
@@ -21,6 +21,16 @@ public:
     void setAutoZoom(bool enabled);
     void setRandomPalette();
     void setPixelSize(int size);
+    void setPeriodicityCheck(bool enabled);
+    void setDerivativeCheck(bool enabled);
+    // Fixed iteration budget (at most IterationBudget::MAX_MAX_ITER), or adaptive
+    // (starting from the default) when 0
+    void setMaxIter(int maxIter);
+    // Polynomial drawn by the Newton engine
+    void setNewtonPolynomial(std::shared_ptr<const NewtonPolynomial> polynomial);
+
+    // Engines of the E key in cycle order, e.g. "Border→Parallel-Border→..."
+    static std::string engineCycleDescription();
 
 private:
     int width;
@@ -44,7 +54,12 @@ private:
     bool verboseMode;
     bool exitAfterFirstDisplay;
     bool autoScreenshotMode;
+    bool periodicityCheck;
+    bool derivativeCheck;
+    int maxIter;          // Budget of the next frame
+    bool adaptiveMaxIter; // Adjust maxIter from each frame's escape counts
     GridMandelbrotCalculator::EngineType currentEngineType;
+    std::shared_ptr<const NewtonPolynomial> newtonPolynomial; // z^3 - 1 when null
 
     void initSDL();
     void switchToOpenGL();
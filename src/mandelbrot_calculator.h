@@ -1,5 +1,6 @@
 #pragma once
 
+#include "high_precision.h"
 #include <vector>
 #include <functional>
 #include <string>
@@ -13,6 +14,14 @@ public:
     // Core computation interface
     virtual void updateBounds(double cre, double cim, double diam) = 0;
     virtual void updateBoundsExplicit(double minR, double minI, double maxR, double maxI) = 0;
+
+    // High-precision placement for zooms below double resolution.
+    // updateBoundsHP centers the view like updateBounds. updateBoundsRelative places it
+    // like updateBoundsExplicit, with the bounds given as offsets from (refR, refI).
+    // Sizes and offsets are FloatExp, so they keep going below the double range.
+    virtual void updateBoundsHP(const HighPrecision &cre, const HighPrecision &cim, FloatExp diam) = 0;
+    virtual void updateBoundsRelative(const HighPrecision &refR, const HighPrecision &refI,
+                                      FloatExp minR, FloatExp minI, FloatExp maxR, FloatExp maxI) = 0;
     virtual void compute(std::function<void()> progressCallback) = 0;
     virtual void reset() = 0;
 
@@ -29,10 +38,36 @@ public:
     virtual double getMinI() const = 0;
     virtual double getStepR() const = 0;
     virtual double getStepI() const = 0;
+    virtual HighPrecision getCreHP() const = 0;
+    virtual HighPrecision getCimHP() const = 0;
+    // Diameter and pixel steps that stay exact below 1e-308, where the double
+    // versions above underflow
+    virtual FloatExp getDiamFE() const = 0;
+    virtual FloatExp getStepRFE() const = 0;
+    virtual FloatExp getStepIFE() const = 0;
+
+    // Smallest diameter the engine still renders correctly
+    virtual FloatExp getMinDiam() const = 0;
 
     // Configuration
     virtual void setSpeedMode(bool mode) = 0;
     virtual bool getSpeedMode() const = 0;
+
+    // Iteration budget of the view: pixels still bounded after maxIter iterations
+    // count as inside the set and report maxIter
+    virtual void setMaxIter(int maxIter) = 0;
+    virtual int getMaxIter() const = 0;
+
+    // Periodicity (cycle) detection: interior points report maxIter as soon as
+    // their orbit repeats instead of running the full iteration budget
+    virtual void setPeriodicityCheck(bool enabled) = 0;
+    virtual bool getPeriodicityCheck() const = 0;
+
+    // Derivative interior detection: interior points report maxIter as soon as
+    // |dz/dz0| shrinks below a threshold, which an attracting cycle makes it do
+    // long before periodicity checking sees the orbit repeat
+    virtual void setDerivativeCheck(bool enabled) = 0;
+    virtual bool getDerivativeCheck() const = 0;
     
     // Engine identification for verbose output
     virtual std::string getEngineName() const = 0;
@@ -41,5 +76,5 @@ public:
     virtual bool hasOwnOutput() const { return false; }
     virtual void render() {}
 
-    static constexpr int MAX_ITER = 768;
+    static constexpr int DEFAULT_MAX_ITER = 768;
 };
@@ -0,0 +1,133 @@
+#include "mariani_silver_mandelbrot_calculator.h"
+#include <algorithm>
+
+MarianiSilverMandelbrotCalculator::MarianiSilverMandelbrotCalculator(int w, int h)
+    : StorageMandelbrotCalculator(w, h), kernels(selectSimdKernels()), activePool(nullptr), view{},
+      evaluated(0), reported(0)
+{
+}
+
+void MarianiSilverMandelbrotCalculator::evaluateRow(int y, int x0, int x1)
+{
+    if (x0 > x1)
+        return;
+    unsigned begin = y * width + x0;
+    kernels.f64(view, begin, begin + (x1 - x0 + 1), data.data());
+    if (progressCallback)
+        evaluated += x1 - x0 + 1;
+}
+
+void MarianiSilverMandelbrotCalculator::evaluateColumn(int x, int y0, int y1)
+{
+    // Gathered in chunks through the list kernel
+    constexpr int CHUNK = 256;
+    unsigned pixels[CHUNK];
+    for (int y = y0; y <= y1; y += CHUNK)
+    {
+        int count = std::min(CHUNK, y1 - y + 1);
+        for (int i = 0; i < count; ++i)
+            pixels[i] = (y + i) * width + x;
+        kernels.f64List(view, pixels, count, data.data());
+    }
+    if (progressCallback && y0 <= y1)
+        evaluated += y1 - y0 + 1;
+}
+
+bool MarianiSilverMandelbrotCalculator::isUniform(const Rect &rect) const
+{
+    const int value = data[rect.y0 * width + rect.x0];
+    for (int x = rect.x0; x <= rect.x1; ++x)
+        if (data[rect.y0 * width + x] != value || data[rect.y1 * width + x] != value)
+            return false;
+    for (int y = rect.y0 + 1; y < rect.y1; ++y)
+        if (data[y * width + rect.x0] != value || data[y * width + rect.x1] != value)
+            return false;
+    return true;
+}
+
+void MarianiSilverMandelbrotCalculator::subdivide(const Rect &rect)
+{
+    const int innerWidth = rect.x1 - rect.x0 - 1;
+    const int innerHeight = rect.y1 - rect.y0 - 1;
+    if (innerWidth <= 0 || innerHeight <= 0)
+        return;
+
+    if (isUniform(rect))
+    {
+        const int value = data[rect.y0 * width + rect.x0];
+        for (int y = rect.y0 + 1; y < rect.y1; ++y)
+            std::fill_n(data.begin() + y * width + rect.x0 + 1, innerWidth, value);
+    }
+    else if (innerWidth * innerHeight <= MIN_AREA)
+    {
+        // Too small to be worth splitting further
+        for (int y = rect.y0 + 1; y < rect.y1; ++y)
+            evaluateRow(y, rect.x0 + 1, rect.x1 - 1);
+    }
+    else
+    {
+        // Split the longer side at its middle line, then both halves have
+        // their whole perimeter evaluated
+        Rect first = rect, second = rect;
+        if (innerWidth >= innerHeight)
+        {
+            int x = (rect.x0 + rect.x1) / 2;
+            evaluateColumn(x, rect.y0 + 1, rect.y1 - 1);
+            first.x1 = second.x0 = x;
+        }
+        else
+        {
+            int y = (rect.y0 + rect.y1) / 2;
+            evaluateRow(y, rect.x0 + 1, rect.x1 - 1);
+            first.y1 = second.y0 = y;
+        }
+
+        // Halves write disjoint interiors: large ones go to the pool
+        if (activePool && innerWidth * innerHeight >= TASK_AREA)
+        {
+            activePool->run([this, second] { subdivide(second); });
+            subdivide(first);
+        }
+        else
+        {
+            subdivide(first);
+            subdivide(second);
+        }
+    }
+
+    // Update display periodically (skip in speed mode)
+    if (progressCallback && evaluated - reported >= 1000)
+    {
+        reported = evaluated;
+        progressCallback();
+    }
+}
+
+void MarianiSilverMandelbrotCalculator::compute(std::function<void()> callback)
+{
+    data.assign(width * height, 0);
+    view = {minr, mini, stepr, stepi, width, periodicityEpsilon(), derivativeEpsilon(), maxIter};
+    evaluated = reported = 0;
+
+    // Speed mode spreads the rectangles over all cores, normal mode runs them on
+    // this thread so the display can follow
+    if (speedMode && !pool)
+        pool = std::make_unique<TaskPool>();
+    activePool = speedMode ? pool.get() : nullptr;
+    progressCallback = speedMode ? nullptr : callback;
+
+    // Perimeter of the whole image
+    evaluateRow(0, 0, width - 1);
+    if (height > 1)
+        evaluateRow(height - 1, 0, width - 1);
+    evaluateColumn(0, 1, height - 2);
+    if (width > 1)
+        evaluateColumn(width - 1, 1, height - 2);
+
+    subdivide({0, 0, width - 1, height - 1});
+    if (activePool)
+        activePool->wait();
+
+    activePool = nullptr;
+    progressCallback = nullptr;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "storage_mandelbrot_calculator.h"
+#include "simd_kernels.h"
+#include "task_pool.h"
+#include <functional>
+#include <memory>
+
+// Mariani-Silver rectangle subdivision: evaluate the perimeter of a rectangle, fill
+// it when the whole perimeter has one value, otherwise split it in two along a line
+// that is evaluated next and recurse. Rows of the perimeter go through the SIMD
+// range kernel, columns through the list kernel. Sub-rectangles only write their
+// own interior, so in speed mode the large ones run as tasks on a pool of all cores.
+class MarianiSilverMandelbrotCalculator : public StorageMandelbrotCalculator
+{
+public:
+    MarianiSilverMandelbrotCalculator(int width, int height);
+
+    void compute(std::function<void()> progressCallback) override;
+
+    std::string getEngineName() const override { return "msilver"; }
+
+private:
+    // Rectangles with at most this many interior pixels are evaluated directly
+    static constexpr int MIN_AREA = 64;
+    // Rectangles with at least this many interior pixels become pool tasks
+    static constexpr int TASK_AREA = 4096;
+
+    // Inclusive pixel bounds, the perimeter is already evaluated
+    struct Rect
+    {
+        int x0, y0, x1, y1;
+    };
+
+    const SimdKernels &kernels;
+    // Created on the first speed mode compute, only used in speed mode
+    std::unique_ptr<TaskPool> pool;
+    TaskPool *activePool;
+    SimdView view;
+    // Progressive display, normal mode only (single thread)
+    std::function<void()> progressCallback;
+    unsigned evaluated, reported;
+
+    void evaluateRow(int y, int x0, int x1);
+    void evaluateColumn(int x, int y0, int y1);
+    bool isUniform(const Rect &rect) const;
+    void subdivide(const Rect &rect);
+};
@@ -0,0 +1,303 @@
+#include "newton_polynomial.h"
+#include <cctype>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+NewtonPolynomial NewtonPolynomial::parse(const std::string &spec)
+{
+    // Whitespace is not significant
+    std::string text;
+    for (char c : spec)
+        if (!std::isspace(static_cast<unsigned char>(c)))
+            text += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+    auto fail = [&](const std::string &what)
+    {
+        return std::invalid_argument("polynomial \"" + spec + "\": " + what);
+    };
+    if (text.empty())
+        throw fail("empty");
+
+    // Coefficient of z^k at index k, terms of the same power add up
+    std::vector<double> byPower;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        double sign = 1;
+        if (text[pos] == '+' || text[pos] == '-')
+            sign = text[pos++] == '-' ? -1 : 1;
+        else if (pos != 0)
+            throw fail("expected + or - before term at position " + std::to_string(pos));
+
+        double coefficient = 1;
+        bool hasNumber = false;
+        if (pos < text.size() && (std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '.'))
+        {
+            size_t used = 0;
+            try
+            {
+                coefficient = std::stod(text.substr(pos), &used);
+            }
+            catch (const std::invalid_argument &)
+            {
+                throw fail("malformed number at position " + std::to_string(pos));
+            }
+            catch (const std::out_of_range &)
+            {
+                throw fail("number out of range at position " + std::to_string(pos));
+            }
+            pos += used;
+            hasNumber = true;
+        }
+        bool multiplied = pos < text.size() && text[pos] == '*';
+        if (multiplied)
+            ++pos;
+
+        int power = 0;
+        if (pos < text.size() && text[pos] == 'z')
+        {
+            ++pos;
+            power = 1;
+            if (pos < text.size() && text[pos] == '^')
+            {
+                ++pos;
+                size_t start = pos;
+                while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])))
+                    ++pos;
+                if (pos == start)
+                    throw fail("expected a power after ^");
+                try
+                {
+                    power = std::stoi(text.substr(start, pos - start));
+                }
+                catch (const std::out_of_range &)
+                {
+                    throw fail("power out of range at position " + std::to_string(start));
+                }
+            }
+        }
+        else if (!hasNumber || multiplied)
+        {
+            throw fail("expected a term at position " + std::to_string(pos));
+        }
+
+        if (power > MAX_DEGREE)
+            throw fail("degree above " + std::to_string(MAX_DEGREE));
+        if (int(byPower.size()) <= power)
+            byPower.resize(power + 1, 0.0);
+        byPower[power] += sign * coefficient;
+    }
+
+    for (double coefficient : byPower)
+        if (!std::isfinite(coefficient))
+            throw fail("coefficient out of double range");
+    while (!byPower.empty() && byPower.back() == 0.0)
+        byPower.pop_back();
+    if (byPower.size() < 3)
+        throw fail("Newton fractals need degree 2 or more");
+
+    return NewtonPolynomial(spec, std::vector<double>(byPower.rbegin(), byPower.rend()));
+}
+
+NewtonPolynomial NewtonPolynomial::load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("cannot open polynomial file " + path);
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first != std::string::npos && line[first] != '#')
+            return parse(line.substr(first, line.find_last_not_of(" \t\r") + 1 - first));
+    }
+    throw std::invalid_argument("no polynomial in " + path);
+}
+
+NewtonPolynomial::NewtonPolynomial(const std::string &spec, std::vector<double> coefficients)
+    : spec(spec), coefficients(std::move(coefficients)), rootCount(0), gridMinR(0), gridMinI(0),
+      gridScale(1), gridCols(1), gridRows(1)
+{
+    const double leading = this->coefficients[0];
+    for (double &coefficient : this->coefficients)
+        coefficient /= leading;
+    findRoots();
+    buildGrid();
+}
+
+void NewtonPolynomial::findRoots()
+{
+    // Durand-Kerner: every root estimate moves by p(z_i) / prod(z_i - z_j) at once
+    using Complex = std::complex<double>;
+    const int degree = getDegree();
+    const std::vector<double> &monic = coefficients;
+
+    // Starting points on a circle that encloses every root (Cauchy bound), turned
+    // off the real axis so conjugate pairs separate
+    double bound = 0;
+    bool finite = true;
+    for (int k = 1; k <= degree; ++k)
+    {
+        bound = std::max(bound, std::abs(monic[k]));
+        finite = finite && std::isfinite(monic[k]);
+    }
+    bound += 1;
+
+    // A leading coefficient tiny against the others puts the bound, or the roots
+    // the iteration heads for, past the double range
+    auto fail = [&]()
+    {
+        return std::invalid_argument("polynomial \"" + spec + "\": roots out of double range");
+    };
+    if (!finite || !std::isfinite(bound))
+        throw fail();
+    std::vector<Complex> roots(degree);
+    for (int i = 0; i < degree; ++i)
+        roots[i] = std::polar(bound, 2 * M_PI * i / degree + 0.4);
+
+    for (int iteration = 0; iteration < 1000; ++iteration)
+    {
+        double change = 0;
+        for (int i = 0; i < degree; ++i)
+        {
+            Complex value = 1;
+            Complex product = 1;
+            for (int k = 1; k <= degree; ++k)
+                value = value * roots[i] + monic[k];
+            for (int j = 0; j < degree; ++j)
+                if (j != i)
+                    product *= roots[i] - roots[j];
+            Complex delta = value / product;
+            roots[i] -= delta;
+            change = std::max(change, std::abs(delta));
+        }
+        if (change < 1e-14 * bound)
+            break;
+    }
+    for (const Complex &root : roots)
+        if (!std::isfinite(root.real()) || !std::isfinite(root.imag()))
+            throw fail();
+
+    // Estimates closer than the convergence distance are one root for the fractal
+    // (a multiple root comes out as a small cluster)
+    const double radius = std::sqrt(THRESHOLD);
+    std::vector<Complex> distinct;
+    std::vector<int> merged;
+    for (const Complex &root : roots)
+    {
+        bool found = false;
+        for (size_t d = 0; d < distinct.size() && !found; ++d)
+        {
+            if (std::abs(root - distinct[d] / double(merged[d])) < radius)
+            {
+                distinct[d] += root;
+                ++merged[d];
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            distinct.push_back(root);
+            merged.push_back(1);
+        }
+    }
+
+    for (size_t d = 0; d < distinct.size(); ++d)
+        distinct[d] /= double(merged[d]);
+
+    // Counterclockwise from the positive real axis, so the colour bands do not depend
+    // on where the iteration started (z^3-1 keeps the order of NewtonCubicFormula)
+    auto angle = [](const Complex &root) {
+        double a = std::arg(root);
+        return a < -1e-9 ? a + 2 * M_PI : std::max(a, 0.0);
+    };
+    std::sort(distinct.begin(), distinct.end(), [&](const Complex &a, const Complex &b) {
+        double angleA = angle(a), angleB = angle(b);
+        if (std::abs(angleA - angleB) > 1e-9)
+            return angleA < angleB;
+        return std::abs(a) < std::abs(b);
+    });
+
+    rootCount = int(distinct.size());
+    rootsR.clear();
+    rootsI.clear();
+    for (const Complex &root : distinct)
+    {
+        rootsR.push_back(root.real());
+        rootsI.push_back(root.imag());
+    }
+    // Root of the cells without one: nothing is within THRESHOLD of it
+    rootsR.push_back(1e300);
+    rootsI.push_back(1e300);
+}
+
+void NewtonPolynomial::buildGrid()
+{
+    const double radius = std::sqrt(THRESHOLD);
+    double minR = rootsR[0], maxR = rootsR[0];
+    double minI = rootsI[0], maxI = rootsI[0];
+    double separation = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < rootCount; ++r)
+    {
+        minR = std::min(minR, rootsR[r]);
+        maxR = std::max(maxR, rootsR[r]);
+        minI = std::min(minI, rootsI[r]);
+        maxI = std::max(maxI, rootsI[r]);
+        for (int s = r + 1; s < rootCount; ++s)
+            separation = std::min(separation, std::hypot(rootsR[r] - rootsR[s], rootsI[r] - rootsI[s]));
+    }
+    minR -= radius;
+    maxR += radius;
+    minI -= radius;
+    maxI += radius;
+
+    // Two roots within radius of the same cell are at most cell * sqrt(2) + 2 radius
+    // apart: below that cell size each cell has one candidate root at most
+    const double extent = std::max(maxR - minR, maxI - minI);
+    double cell = std::min(extent, (separation - 2 * radius) / 2);
+    cell = std::max(cell, extent / MAX_GRID_SIZE);
+
+    gridScale = 1 / cell;
+    gridMinR = minR - cell;
+    gridMinI = minI - cell;
+    gridCols = std::max(1, int(std::ceil((maxR - minR) / cell))) + 2;
+    gridRows = std::max(1, int(std::ceil((maxI - minI) / cell))) + 2;
+
+    // A cell keeps the roots within radius of its rectangle; when roots are too close
+    // for the grid, the one nearest to the cell centre
+    cells.assign(gridCols * gridRows, rootCount);
+    for (int j = 1; j < gridRows - 1; ++j)
+    {
+        for (int i = 1; i < gridCols - 1; ++i)
+        {
+            const double x0 = gridMinR + i * cell, x1 = x0 + cell;
+            const double y0 = gridMinI + j * cell, y1 = y0 + cell;
+            double nearest = std::numeric_limits<double>::infinity();
+            for (int r = 0; r < rootCount; ++r)
+            {
+                double dx = std::max(0.0, std::max(x0 - rootsR[r], rootsR[r] - x1));
+                double dy = std::max(0.0, std::max(y0 - rootsI[r], rootsI[r] - y1));
+                if (dx * dx + dy * dy > THRESHOLD)
+                    continue;
+                double centre = std::hypot(rootsR[r] - (x0 + x1) / 2, rootsI[r] - (y0 + y1) / 2);
+                if (centre < nearest)
+                {
+                    nearest = centre;
+                    cells[j * gridCols + i] = r;
+                }
+            }
+        }
+    }
+
+    cellRootsR.resize(cells.size());
+    cellRootsI.resize(cells.size());
+    for (size_t c = 0; c < cells.size(); ++c)
+    {
+        cellRootsR[c] = rootsR[cells[c]];
+        cellRootsI[c] = rootsI[cells[c]];
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Polynomial with real coefficients whose Newton fractal the newton engine draws.
+// The roots are found once up front, and a uniform grid over them tells which root
+// a point may be converging to: the convergence test looks up one candidate root
+// per iteration instead of measuring the distance to every root.
+class NewtonPolynomial
+{
+public:
+    // Squared distance to a root at which a point counts as converged
+    static constexpr double THRESHOLD = .00001;
+    // Degrees past this one still work, with a slower runtime-degree kernel
+    static constexpr int MAX_DEGREE = 64;
+
+    // Parses a polynomial in z such as "z^3-1", "z^8+15z^4-16" or "2*z^5 - 3z + 0.5".
+    // Throws std::invalid_argument unless it is a polynomial of degree 2 or more
+    // whose coefficients and roots fit in double.
+    static NewtonPolynomial parse(const std::string &spec);
+    // Same with the spec read from a file: first line that is not empty or a # comment
+    static NewtonPolynomial load(const std::string &path);
+
+    const std::string &getSpec() const { return spec; }
+    int getDegree() const { return int(coefficients.size()) - 1; }
+    // Highest degree first, divided by the leading one (Newton's method does not see
+    // the scale), so the leading coefficient is always 1
+    const std::vector<double> &getCoefficients() const { return coefficients; }
+    // Distinct roots: a multiple root counts once
+    int getRootCount() const { return rootCount; }
+
+    // Index of the only root that can be within THRESHOLD of z, getRootCount() when
+    // none is. Branch free, so it vectorizes inside the batch loops.
+    int candidateRoot(double zr, double zi) const { return cells[cellAt(zr, zi)]; }
+
+    // Whether z is within THRESHOLD of a root: the candidate root coordinates are
+    // stored per cell, so the test costs no second lookup
+    bool isConverged(double zr, double zi) const
+    {
+        int cell = cellAt(zr, zi);
+        double dr = zr - cellRootsR[cell];
+        double di = zi - cellRootsI[cell];
+        return dr * dr + di * di <= THRESHOLD;
+    }
+
+    double rootR(int root) const { return rootsR[root]; }
+    double rootI(int root) const { return rootsI[root]; }
+
+private:
+    // Cells per side at most, roots closer than the grid resolves share cells
+    static constexpr int MAX_GRID_SIZE = 256;
+
+    std::string spec;
+    std::vector<double> coefficients;
+    int rootCount;
+    std::vector<double> rootsR, rootsI;
+
+    double gridMinR, gridMinI; // Corner of the border
+    double gridScale;          // Cells per unit
+    int gridCols, gridRows;    // Border included
+    // Candidate root per cell, row-major, in a border of cells without one, and
+    // its coordinates (far away from everything for cells without one)
+    std::vector<int> cells;
+    std::vector<double> cellRootsR, cellRootsI;
+
+    NewtonPolynomial(const std::string &spec, std::vector<double> coefficients);
+
+    int cellAt(double zr, double zi) const
+    {
+        // Points off the grid are clamped into its border, which has no root; the
+        // clamping also sends NaN there
+        double u = std::min(double(gridCols - 1), std::max(0.0, (zr - gridMinR) * gridScale));
+        double v = std::min(double(gridRows - 1), std::max(0.0, (zi - gridMinI) * gridScale));
+        return int(v) * gridCols + int(u);
+    }
+
+    void findRoots();
+    void buildGrid();
+};
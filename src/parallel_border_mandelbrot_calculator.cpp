@@ -0,0 +1,227 @@
+#include "parallel_border_mandelbrot_calculator.h"
+#include "interior_fill.h"
+#include <algorithm>
+#include <thread>
+
+ParallelBorderMandelbrotCalculator::ParallelBorderMandelbrotCalculator(int w, int h)
+    : StorageMandelbrotCalculator(w, h), kernels(selectSimdKernels()),
+      done(new std::atomic<unsigned char>[w * h]), pending(0), periodEps(0.0), derivativeEps(0.0)
+{
+    clearFlags();
+
+    unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned t = 0; t < numThreads; ++t)
+        workers.push_back(std::make_unique<Worker>());
+}
+
+void ParallelBorderMandelbrotCalculator::reset()
+{
+    StorageMandelbrotCalculator::reset();
+    clearFlags();
+}
+
+void ParallelBorderMandelbrotCalculator::clearFlags()
+{
+    // Relaxed plain stores: std::fill would issue a full barrier per pixel
+    for (int p = 0; p < width * height; ++p)
+        done[p].store(0, std::memory_order_relaxed);
+}
+
+void ParallelBorderMandelbrotCalculator::addQueue(Worker &worker, unsigned p)
+{
+    // Plain load first: most neighbors are already queued, skip the atomic write
+    if (done[p].load(std::memory_order_relaxed) & QUEUED)
+        return;
+    if (done[p].fetch_or(QUEUED, std::memory_order_relaxed) & QUEUED)
+        return;
+    worker.added.push_back(p);
+}
+
+void ParallelBorderMandelbrotCalculator::request(Worker &worker, unsigned p)
+{
+    unsigned char flags = done[p].load(std::memory_order_acquire);
+    if (flags & LOADED)
+        return;
+    if (!(flags & CLAIMED))
+    {
+        flags = done[p].fetch_or(CLAIMED, std::memory_order_acq_rel);
+        if (!(flags & CLAIMED))
+        {
+            worker.claimed.push_back(p);
+            return;
+        }
+    }
+    // Claimed by another thread (or earlier in this batch)
+    if (!(flags & LOADED))
+        worker.awaited.push_back(p);
+}
+
+void ParallelBorderMandelbrotCalculator::loadBatch(Worker &worker, const unsigned *batch, int count)
+{
+    // Every pixel scan() reads: the batch pixels and their 4 neighbors
+    worker.claimed.clear();
+    worker.awaited.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        unsigned p = batch[i];
+        int x = p % width;
+        int y = p / width;
+        request(worker, p);
+        if (x >= 1)
+            request(worker, p - 1);
+        if (x < width - 1)
+            request(worker, p + 1);
+        if (y >= 1)
+            request(worker, p - width);
+        if (y < height - 1)
+            request(worker, p + width);
+    }
+
+    // Pixels of different threads never share an int, the kernel writes in place
+    const SimdView view = {minr, mini, stepr, stepi, width, periodEps, derivativeEps, maxIter};
+    kernels.f64List(view, worker.claimed.data(), worker.claimed.size(), data.data());
+    for (unsigned p : worker.claimed)
+        done[p].fetch_or(LOADED, std::memory_order_release);
+
+    // The owners publish their claimed pixels before waiting on anything,
+    // so the wait is short and cannot go round in a cycle
+    for (unsigned p : worker.awaited)
+        while (!(done[p].load(std::memory_order_acquire) & LOADED))
+            std::this_thread::yield();
+}
+
+void ParallelBorderMandelbrotCalculator::scan(Worker &worker, unsigned p)
+{
+    int x = p % width;
+    int y = p / width;
+
+    int center = data[p];
+
+    bool ll = x >= 1;
+    bool rr = x < width - 1;
+    bool uu = y >= 1;
+    bool dd = y < height - 1;
+
+    // Check if neighbors differ from center
+    bool l = ll && data[p - 1] != center;
+    bool r = rr && data[p + 1] != center;
+    bool u = uu && data[p - width] != center;
+    bool d = dd && data[p + width] != center;
+
+    if (l)
+        addQueue(worker, p - 1);
+    if (r)
+        addQueue(worker, p + 1);
+    if (u)
+        addQueue(worker, p - width);
+    if (d)
+        addQueue(worker, p + width);
+
+    // Check corner pixels (diagonal neighbors)
+    if ((uu && ll) && (l || u))
+        addQueue(worker, p - width - 1);
+    if ((uu && rr) && (r || u))
+        addQueue(worker, p - width + 1);
+    if ((dd && ll) && (l || d))
+        addQueue(worker, p + width - 1);
+    if ((dd && rr) && (r || d))
+        addQueue(worker, p + width + 1);
+}
+
+size_t ParallelBorderMandelbrotCalculator::takeBatch(unsigned index, unsigned *batch)
+{
+    size_t count = workers[index]->deque.pop(batch, BATCH_SIZE);
+    for (size_t i = 1; count == 0 && i < workers.size(); ++i)
+        count = workers[(index + i) % workers.size()]->deque.steal(batch, BATCH_SIZE);
+    return count;
+}
+
+void ParallelBorderMandelbrotCalculator::trace(unsigned index, std::function<void()> progressCallback)
+{
+    Worker &worker = *workers[index];
+    unsigned batch[BATCH_SIZE];
+    unsigned processed = 0;
+    unsigned reported = 0;
+
+    for (;;)
+    {
+        size_t count = takeBatch(index, batch);
+        if (count == 0)
+        {
+            // Nothing to take: done once no pixel is left queued or being scanned
+            if (pending.load(std::memory_order_acquire) == 0)
+                return;
+            std::this_thread::yield();
+            continue;
+        }
+
+        loadBatch(worker, batch, count);
+        for (size_t i = 0; i < count; ++i)
+            scan(worker, batch[i]);
+
+        // Count the new pixels before retiring the batch so pending never reads 0 early
+        if (!worker.added.empty())
+        {
+            pending.fetch_add(worker.added.size(), std::memory_order_acq_rel);
+            worker.deque.push(worker.added.data(), worker.added.size());
+            worker.added.clear();
+        }
+        pending.fetch_sub(count, std::memory_order_acq_rel);
+
+        // Only a calling thread tracing alone updates the display (see compute)
+        processed += count;
+        if (progressCallback && processed - reported >= 1000)
+        {
+            reported = processed;
+            progressCallback();
+        }
+    }
+}
+
+void ParallelBorderMandelbrotCalculator::compute(std::function<void()> progressCallback)
+{
+    data.assign(width * height, 0);
+    clearFlags();
+    periodEps = periodicityEpsilon();
+    derivativeEps = derivativeEpsilon();
+
+    // Screen edges, cut in one contiguous run per thread
+    std::vector<unsigned> edges;
+    for (int y = 0; y < height; ++y)
+    {
+        edges.push_back(y * width + 0);
+        if (width > 1)
+            edges.push_back(y * width + (width - 1));
+    }
+    for (int x = 1; x < width - 1; ++x)
+    {
+        edges.push_back(0 * width + x);
+        if (height > 1)
+            edges.push_back((height - 1) * width + x);
+    }
+    for (unsigned p : edges)
+        done[p].store(QUEUED, std::memory_order_relaxed);
+
+    const size_t numThreads = workers.size();
+    const size_t share = (edges.size() + numThreads - 1) / numThreads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        size_t begin = std::min(edges.size(), t * share);
+        size_t end = std::min(edges.size(), begin + share);
+        workers[t]->deque.push(edges.data() + begin, end - begin);
+    }
+    pending.store(edges.size(), std::memory_order_release);
+
+    // The calling thread traces too. It only reports progress when it traces alone:
+    // the display reads data, which the other threads write until they are joined.
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; ++t)
+        threads.emplace_back(&ParallelBorderMandelbrotCalculator::trace, this, t, nullptr);
+    trace(0, speedMode || numThreads > 1 ? nullptr : progressCallback);
+    for (auto &thread : threads)
+        thread.join();
+
+    // Fill uncalculated areas with neighbor color
+    fillUntracedPixels(data.data(), width, height,
+                       [this](unsigned p) { return done[p].load(std::memory_order_relaxed) & LOADED; });
+}
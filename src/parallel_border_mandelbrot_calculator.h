@@ -0,0 +1,63 @@
+#pragma once
+
+#include "storage_mandelbrot_calculator.h"
+#include "simd_kernels.h"
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Boundary tracing of one image by all cores at once. Same tracing as
+// BorderMandelbrotCalculator, but the threads share the data and flag buffers: each
+// one scans pixels from its own work-stealing deque and idle threads steal from the
+// others, so there are no tile seams to trace twice and the threads follow the detail
+// wherever it is. Flags are updated atomically; a pixel is computed by the thread
+// that claims it first, the others wait for it to be published.
+class ParallelBorderMandelbrotCalculator : public StorageMandelbrotCalculator
+{
+public:
+    ParallelBorderMandelbrotCalculator(int width, int height);
+
+    void compute(std::function<void()> progressCallback) override;
+    void reset() override;
+
+    std::string getEngineName() const override { return "pborder"; }
+
+private:
+    // Pixels a thread takes from its deque and scans together
+    static constexpr int BATCH_SIZE = 32;
+
+    enum Flags
+    {
+        LOADED = 1,  // data[p] holds the value of the pixel
+        QUEUED = 2,  // Added to a deque once, never again
+        CLAIMED = 4  // Being computed by some thread
+    };
+
+    // State of one tracing thread
+    struct Worker
+    {
+        WorkStealingDeque<unsigned> deque;
+        // Pixels added by the current batch, pushed to the deque all at once
+        std::vector<unsigned> added;
+        // Pixels this thread computes, and pixels it waits for from other threads
+        std::vector<unsigned> claimed, awaited;
+    };
+
+    const SimdKernels &kernels;
+    std::unique_ptr<std::atomic<unsigned char>[]> done;
+    std::vector<std::unique_ptr<Worker>> workers;
+    // Queued pixels not scanned yet, the tracing ends when it drops to 0
+    std::atomic<long> pending;
+    double periodEps;
+    double derivativeEps;
+
+    void clearFlags();
+    void addQueue(Worker &worker, unsigned p);
+    void request(Worker &worker, unsigned p);
+    void loadBatch(Worker &worker, const unsigned *batch, int count);
+    void scan(Worker &worker, unsigned p);
+    size_t takeBatch(unsigned index, unsigned *batch);
+    void trace(unsigned index, std::function<void()> progressCallback);
+};
@@ -0,0 +1,67 @@
+#include "perturbation_mandelbrot_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+PerturbationMandelbrotCalculator::PerturbationMandelbrotCalculator(int w, int h)
+    : BorderMandelbrotCalculator(w, h)
+{
+}
+
+void PerturbationMandelbrotCalculator::setView(std::shared_ptr<PerturbationView> newView)
+{
+    sharedView = std::move(newView);
+}
+
+FloatExp PerturbationMandelbrotCalculator::getMinDiam() const
+{
+    // Offsets and deltas go FloatExp on deep views: stop where the reference
+    // orbit reaches its largest precision
+    return FloatExp::normalize(1.0, BigFixed::MIN_DIAM_EXPONENT);
+}
+
+void PerturbationMandelbrotCalculator::iteratePixels(const unsigned *pixels, unsigned count)
+{
+    // Pixels rebase at different iterations, each one runs its own loop
+    if (view->usesFloatExp())
+    {
+        for (unsigned i = 0; i < count; ++i)
+        {
+            unsigned p = pixels[i];
+            FloatExp dcr = deepMinR + FloatExp(p % width) * deepStepR;
+            FloatExp dci = deepMinI + FloatExp(p / width) * deepStepI;
+            data[p] = view->iterate<FloatExp>(dcr, dci);
+        }
+        return;
+    }
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        unsigned p = pixels[i];
+        double dcr = dminr + (p % width) * stepr;
+        double dci = dmini + (p / width) * stepi;
+        data[p] = view->iterate<double>(dcr, dci);
+    }
+}
+
+void PerturbationMandelbrotCalculator::compute(std::function<void()> progressCallback)
+{
+    view = sharedView;
+    if (!view)
+        view = std::make_shared<PerturbationView>(refr, refi, deepMinR, deepMinI,
+                                                  deepMinR + FloatExp(width) * deepStepR,
+                                                  deepMinI + FloatExp(height) * deepStepI, maxIter);
+    view->prepare();
+
+    BorderMandelbrotCalculator::compute(progressCallback);
+}
+
+std::string PerturbationMandelbrotCalculator::getEngineName() const
+{
+    std::string name = " pert";
+    if (view && view->getSkip() > 0)
+        name += "/sa" + std::to_string(view->getSkip());
+    if (view && view->usesFloatExp())
+        name += "/fe";
+    return name;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "border_mandelbrot_calculator.h"
+#include "perturbation_view.h"
+#include <functional>
+#include <memory>
+
+// Perturbation implementation for deep zooms: one reference orbit is computed in
+// high precision at the reference point of the view, every pixel then iterates in
+// plain double as the difference to that orbit, starting where the series
+// approximation leaves it. Pixels rebase onto the start of the orbit when they get
+// closer to 0 than to the reference or run past its end, so any reference point works.
+// Pixels are visited by the boundary tracing of BorderMandelbrotCalculator.
+// Offsets and deltas are plain double until the view nears the double underflow
+// threshold, FloatExp (double mantissa, 64-bit exponent) below it.
+class PerturbationMandelbrotCalculator : public BorderMandelbrotCalculator
+{
+public:
+    PerturbationMandelbrotCalculator(int width, int height);
+
+    // Shares the orbit and series of a view with other calculators (grid tiles).
+    // Without one the calculator builds its own from its bounds on every compute.
+    void setView(std::shared_ptr<PerturbationView> view);
+
+    void compute(std::function<void()> progressCallback) override;
+
+    // Shows the number of iterations skipped by the series approximation
+    std::string getEngineName() const override;
+
+    // Limited by the precision of the reference orbit (BigFixed::MIN_DIAM_EXPONENT)
+    // instead of the double coordinates
+    FloatExp getMinDiam() const override;
+
+protected:
+    void iteratePixels(const unsigned *pixels, unsigned count) override;
+
+private:
+    std::shared_ptr<PerturbationView> sharedView;
+    std::shared_ptr<PerturbationView> view;
+};
@@ -0,0 +1,109 @@
+#include "perturbation_view.h"
+#include "mandelbrot_calculator.h"
+#include <algorithm>
+#include <cmath>
+
+PerturbationView::PerturbationView(const HighPrecision &refR, const HighPrecision &refI,
+                                   FloatExp minR, FloatExp minI, FloatExp maxR, FloatExp maxI, int maxIter)
+    : refr(refR), refi(refI), minr(minR), mini(minI), maxr(maxR), maxi(maxI), maxIter(maxIter)
+{
+    dcMax = std::max({hypot(minr, mini), hypot(maxr, mini),
+                      hypot(minr, maxi), hypot(maxr, maxi)});
+    deep = std::min(maxr - minr, maxi - mini) < FloatExp(FLOATEXP_DIAM);
+}
+
+void PerturbationView::prepare()
+{
+    std::call_once(prepared, [this]()
+                   {
+        orbit.compute(refr, refi, maxIter, std::min(maxr - minr, maxi - mini));
+        if (deep)
+        {
+            deepTables.series.compute(orbit, minr, mini, maxr, maxi);
+            deepTables.bla.compute(orbit, dcMax);
+        }
+        else
+        {
+            tables.series.compute(orbit, minr.toDouble(), mini.toDouble(), maxr.toDouble(), maxi.toDouble());
+            tables.bla.compute(orbit, dcMax.toDouble());
+        } });
+}
+
+template <>
+const PerturbationView::Tables<double> &PerturbationView::tablesFor<double>() const
+{
+    return tables;
+}
+
+template <>
+const PerturbationView::Tables<FloatExp> &PerturbationView::tablesFor<FloatExp>() const
+{
+    return deepTables;
+}
+
+template <class Delta>
+int PerturbationView::iterate(Delta cr, Delta ci) const
+{
+    const SeriesApproximation<Delta> &series = tablesFor<Delta>().series;
+    const BlaTable<Delta> &bla = tablesFor<Delta>().bla;
+
+    // z = Z(m) + dz, starting where the series leaves the pixel.
+    // iter counts the iterations done, z is z(iter).
+    OrbitStart<Delta> start = series.start(cr, ci);
+    Delta dzr = start.dzr, dzi = start.dzi;
+    int m = start.iter;
+    int iter = start.iter;
+    const int last = orbit.size() - 1;
+
+    while (iter < maxIter)
+    {
+        int length;
+        const BlaStep<Delta> *step = bla.lookup(m, dzr * dzr + dzi * dzi, maxIter - iter, length);
+        if (step)
+        {
+            // dz = A * dz + B * dc over length iterations
+            Delta ar = step->ar, ai = step->ai;
+            Delta br = step->br, bi = step->bi;
+            Delta nr = ar * dzr - ai * dzi + br * cr - bi * ci;
+            Delta ni = ar * dzi + ai * dzr + br * ci + bi * cr;
+            dzr = nr;
+            dzi = ni;
+            m += length;
+            iter += length;
+        }
+        else
+        {
+            Delta refR = orbit.getR(m);
+            Delta refI = orbit.getI(m);
+
+            // dz = 2 * Z * dz + dz^2 + dc
+            Delta nr = Delta(2.0) * (refR * dzr - refI * dzi) + (dzr * dzr - dzi * dzi) + cr;
+            Delta ni = Delta(2.0) * (refR * dzi + refI * dzr) + Delta(2.0) * dzr * dzi + ci;
+            dzr = nr;
+            dzi = ni;
+            ++m;
+            ++iter;
+        }
+
+        double r = orbit.getR(m) + toDouble(dzr);
+        double i = orbit.getI(m) + toDouble(dzi);
+        double mag2 = r * r + i * i;
+
+        // Same count as the scalar engines: the iteration that produced z(iter)
+        if (mag2 >= 4.0)
+            return iter - 1;
+
+        if (mag2 < toDouble(dzr * dzr + dzi * dzi) || m == last)
+        {
+            // Rebase: continue from Z(0) = 0 with the full value as delta
+            dzr = r;
+            dzi = i;
+            m = 0;
+        }
+    }
+
+    return maxIter;
+}
+
+template int PerturbationView::iterate<double>(double dcr, double dci) const;
+template int PerturbationView::iterate<FloatExp>(FloatExp dcr, FloatExp dci) const;
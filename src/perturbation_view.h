@@ -0,0 +1,62 @@
+#pragma once
+
+#include "high_precision.h"
+#include "reference_orbit.h"
+#include "series_approximation.h"
+#include "bla_table.h"
+#include "float_exp.h"
+#include <mutex>
+
+// Everything the perturbation pixel kernel needs for one view: the reference orbit,
+// the series approximation giving each pixel its starting iteration and delta, and
+// the BLA table letting it jump over runs of iterations afterwards.
+// GridMandelbrotCalculator builds one per view and shares it between its tiles, so
+// all of them are computed once per frame whatever the grid size.
+// Views smaller than FLOATEXP_DIAM keep offsets, deltas, series and table in FloatExp,
+// which has no underflow; larger ones stay in plain double.
+class PerturbationView
+{
+public:
+    // Bounds of the whole view, as offsets from the reference point
+    PerturbationView(const HighPrecision &refR, const HighPrecision &refI,
+                     FloatExp minR, FloatExp minI, FloatExp maxR, FloatExp maxI, int maxIter);
+
+    // Computes the orbit, series and table on first use, concurrent callers wait for it
+    void prepare();
+
+    // Whether pixels must iterate with Delta = FloatExp
+    bool usesFloatExp() const { return deep; }
+
+    // Iteration count of the pixel at offset dc from the reference point, with the
+    // delta to the orbit kept as Delta: double, or FloatExp for a deep view
+    template <class Delta>
+    int iterate(Delta dcr, Delta dci) const;
+
+    int getSkip() const { return deep ? deepTables.series.getSkip() : tables.series.getSkip(); }
+
+    // View size below which deltas switch to FloatExp. Leaves about 60 bits of
+    // headroom above the smallest normal double for deltas shrinking near the orbit.
+    static constexpr double FLOATEXP_DIAM = 1e-290;
+
+private:
+    template <class Real>
+    struct Tables
+    {
+        SeriesApproximation<Real> series;
+        BlaTable<Real> bla;
+    };
+
+    HighPrecision refr, refi;
+    FloatExp minr, mini, maxr, maxi;
+    FloatExp dcMax; // Largest pixel offset
+    int maxIter;
+    bool deep;
+
+    ReferenceOrbit orbit;
+    Tables<double> tables;       // Unless deep
+    Tables<FloatExp> deepTables; // When deep
+    std::once_flag prepared;
+
+    template <class Real>
+    const Tables<Real> &tablesFor() const;
+};
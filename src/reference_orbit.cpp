@@ -0,0 +1,33 @@
+#include "reference_orbit.h"
+
+void ReferenceOrbit::compute(const HighPrecision &cr, const HighPrecision &ci, int maxIter, FloatExp diam)
+{
+    zr.clear();
+    zi.clear();
+    zr.reserve(maxIter + 1);
+    zi.reserve(maxIter + 1);
+
+    // C itself is truncated too: far below the pixel size it only moves the reference
+    const int limbs = HighPrecision::limbsForDiam(diam);
+    const HighPrecision x = cr.withPrecision(limbs);
+    const HighPrecision y = ci.withPrecision(limbs);
+
+    HighPrecision r(0.0, limbs), i(0.0, limbs);
+    for (int m = 0; m <= maxIter; ++m)
+    {
+        double dr = r.toDouble();
+        double di = i.toDouble();
+        zr.push_back(dr);
+        zi.push_back(di);
+
+        // Keep the first escaped point: pixels reaching it rebase from there
+        if (dr * dr + di * di >= 4.0)
+            break;
+
+        HighPrecision r2 = r * r;
+        HighPrecision i2 = i * i;
+        HighPrecision ri = r * i;
+        i = ri + ri + y; // Z = Z^2 + C
+        r = r2 - i2 + x;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "high_precision.h"
+#include <vector>
+
+// Orbit Z(m+1) = Z(m)^2 + C of a reference point C, iterated in high precision
+// from Z(0) = 0 and stored rounded to double. Perturbation engines iterate each
+// pixel c = C + dc as a small delta dz around it. The precision follows the depth
+// of the view: log2(1 / diam) bits plus guard bits (see BigFixed::limbsForDiam).
+class ReferenceOrbit
+{
+public:
+    // Iterates until Z escapes (|Z| >= 2) or maxIter + 1 points are stored,
+    // precise enough for a view of size diam
+    void compute(const HighPrecision &cr, const HighPrecision &ci, int maxIter, FloatExp diam);
+
+    int size() const { return static_cast<int>(zr.size()); }
+    double getR(int m) const { return zr[m]; }
+    double getI(int m) const { return zi[m]; }
+
+private:
+    std::vector<double> zr, zi;
+};
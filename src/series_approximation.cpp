@@ -0,0 +1,159 @@
+#include "series_approximation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Highest term over first term at the edge of the view: beyond this the
+// truncated series is no longer trusted
+constexpr double TERM_TOLERANCE = 1e-12;
+// Relative error allowed between the series and a regularly iterated probe
+constexpr double PROBE_TOLERANCE = 1e-6;
+} // namespace
+
+template <class Real>
+SeriesApproximation<Real>::SeriesApproximation() : skip(0)
+{
+}
+
+template <class Real>
+int SeriesApproximation<Real>::fit(const ReferenceOrbit &orbit, Real radius)
+{
+    using std::hypot;
+    using std::isfinite;
+
+    // dz(0) = 0: every coefficient starts at zero
+    historyR.assign(TERMS, Real(0.0));
+    historyI.assign(TERMS, Real(0.0));
+
+    Real ar[TERMS] = {}, ai[TERMS] = {};
+    Real nr[TERMS], ni[TERMS];
+
+    // radius^(k - 1) for the truncation check
+    Real radiusPow = 1.0;
+    for (int k = 1; k < TERMS; ++k)
+        radiusPow *= radius;
+
+    // Stop one short of the last orbit point so pixels always have a step to take
+    int n;
+    for (n = 0; n + 2 < orbit.size(); ++n)
+    {
+        Real zr2 = 2.0 * orbit.getR(n);
+        Real zi2 = 2.0 * orbit.getI(n);
+
+        // dz(n + 1) = 2 Z(n) dz(n) + dz(n)^2 + dc, collected by powers of dc:
+        // a_k(n + 1) = 2 Z a_k + sum(a_i a_j, i + j = k) (+ 1 for k = 1)
+        for (int k = 0; k < TERMS; ++k)
+        {
+            Real sr = zr2 * ar[k] - zi2 * ai[k];
+            Real si = zr2 * ai[k] + zi2 * ar[k];
+            for (int i = 0, j = k - 1; i < j; ++i, --j)
+            {
+                sr += Real(2.0) * (ar[i] * ar[j] - ai[i] * ai[j]);
+                si += Real(2.0) * (ar[i] * ai[j] + ai[i] * ar[j]);
+            }
+            if (k % 2 == 1)
+            {
+                int h = k / 2;
+                sr += ar[h] * ar[h] - ai[h] * ai[h];
+                si += Real(2.0) * ar[h] * ai[h];
+            }
+            nr[k] = sr;
+            ni[k] = si;
+        }
+        nr[0] += Real(1.0);
+
+        Real first = hypot(nr[0], ni[0]);
+        Real last = hypot(nr[TERMS - 1], ni[TERMS - 1]) * radiusPow;
+        if (!isfinite(first) || !isfinite(last) || last > Real(TERM_TOLERANCE) * first)
+            break;
+
+        std::copy(nr, nr + TERMS, ar);
+        std::copy(ni, ni + TERMS, ai);
+        historyR.insert(historyR.end(), ar, ar + TERMS);
+        historyI.insert(historyI.end(), ai, ai + TERMS);
+    }
+
+    return n;
+}
+
+template <class Real>
+void SeriesApproximation<Real>::evaluate(int n, Real dcr, Real dci, Real &dzr, Real &dzi) const
+{
+    const Real *ar = &historyR[n * TERMS];
+    const Real *ai = &historyI[n * TERMS];
+
+    // Horner: dz = dc * (a1 + dc * (a2 + ...))
+    Real r = ar[TERMS - 1], i = ai[TERMS - 1];
+    for (int k = TERMS - 2; k >= 0; --k)
+    {
+        Real t = r * dcr - i * dci + ar[k];
+        i = r * dci + i * dcr + ai[k];
+        r = t;
+    }
+    dzr = r * dcr - i * dci;
+    dzi = r * dci + i * dcr;
+}
+
+template <class Real>
+int SeriesApproximation<Real>::validate(const ReferenceOrbit &orbit, int maxSkip, Real dcr, Real dci) const
+{
+    using std::hypot;
+
+    // Iterate the probe without the series and keep the longest prefix where
+    // the series agrees with it and the probe has not escaped yet
+    Real dzr = 0.0, dzi = 0.0;
+    for (int n = 0; n < maxSkip; ++n)
+    {
+        Real refR = orbit.getR(n);
+        Real refI = orbit.getI(n);
+        Real nr = Real(2.0) * (refR * dzr - refI * dzi) + (dzr * dzr - dzi * dzi) + dcr;
+        Real ni = Real(2.0) * (refR * dzi + refI * dzr) + Real(2.0) * dzr * dzi + dci;
+        dzr = nr;
+        dzi = ni;
+
+        // A pixel escaping at this step must still run it itself
+        double r = orbit.getR(n + 1) + toDouble(dzr);
+        double i = orbit.getI(n + 1) + toDouble(dzi);
+        if (r * r + i * i >= 4.0)
+            return n;
+
+        Real sr, si;
+        evaluate(n + 1, dcr, dci, sr, si);
+        if (hypot(sr - dzr, si - dzi) > Real(PROBE_TOLERANCE) * hypot(dzr, dzi))
+            return n;
+    }
+    return maxSkip;
+}
+
+template <class Real>
+void SeriesApproximation<Real>::compute(const ReferenceOrbit &orbit, Real minR, Real minI, Real maxR, Real maxI)
+{
+    using std::hypot;
+
+    // Largest pixel offset, found at one of the corners
+    Real radius = std::max({hypot(minR, minI), hypot(maxR, minI),
+                            hypot(minR, maxI), hypot(maxR, maxI)});
+
+    skip = fit(orbit, radius);
+
+    // Corners and edge midpoints of the view
+    Real midR = (minR + maxR) / Real(2.0);
+    Real midI = (minI + maxI) / Real(2.0);
+    const Real probes[][2] = {{minR, minI}, {maxR, minI}, {minR, maxI}, {maxR, maxI},
+                              {midR, minI}, {midR, maxI}, {minR, midI}, {maxR, midI}};
+    for (const auto &probe : probes)
+        skip = validate(orbit, skip, probe[0], probe[1]);
+}
+
+template <class Real>
+OrbitStart<Real> SeriesApproximation<Real>::start(Real dcr, Real dci) const
+{
+    OrbitStart<Real> result = {skip, Real(0.0), Real(0.0)};
+    if (skip > 0)
+        evaluate(skip, dcr, dci, result.dzr, result.dzi);
+    return result;
+}
+
+template class SeriesApproximation<double>;
+template class SeriesApproximation<FloatExp>;
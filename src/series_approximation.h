@@ -0,0 +1,48 @@
+#pragma once
+
+#include "reference_orbit.h"
+#include "float_exp.h"
+#include <vector>
+
+// Where a pixel starts its perturbed iteration: the iteration count reached and
+// the delta from the reference orbit at that iteration
+template <class Real>
+struct OrbitStart
+{
+    int iter;
+    Real dzr, dzi;
+};
+
+// Series approximation: along the reference orbit the delta of a pixel at offset dc
+// is a polynomial dz(n) = a1(n) dc + a2(n) dc^2 + ... in dc. The coefficients are
+// iterated alongside the orbit for as long as the truncated series stays accurate over
+// the whole view, then every pixel jumps straight to that iteration.
+// Real is double, or FloatExp for views deeper than the double range, where the
+// offsets underflow and the coefficients of the higher terms overflow.
+template <class Real>
+class SeriesApproximation
+{
+public:
+    static constexpr int TERMS = 8;
+
+    SeriesApproximation();
+
+    // Fits the series over the view bounds (offsets from the reference point) and
+    // validates the skip against probe pixels iterated the regular way
+    void compute(const ReferenceOrbit &orbit, Real minR, Real minI, Real maxR, Real maxI);
+
+    // Iterations every pixel skips
+    int getSkip() const { return skip; }
+
+    OrbitStart<Real> start(Real dcr, Real dci) const;
+
+private:
+    int skip;
+
+    // Coefficients of every fitted iteration, TERMS per iteration with a1 first
+    std::vector<Real> historyR, historyI;
+
+    int fit(const ReferenceOrbit &orbit, Real radius);
+    int validate(const ReferenceOrbit &orbit, int maxSkip, Real dcr, Real dci) const;
+    void evaluate(int n, Real dcr, Real dci, Real &dzr, Real &dzi) const;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+// Geometry of the pixel grid a SIMD kernel works on.
+// Pixel p maps to x = p % width, y = p / width and c = (minr + x * stepr, mini + y * stepi).
+struct SimdView
+{
+    double minr, mini;
+    double stepr, stepi;
+    int width;
+    double periodEps;     // Periodicity check distance, 0 disables the check
+    double derivativeEps; // Squared |dz/dz0| of derivative interior detection, 0 disables it
+    int maxIter;
+};
+
+// Streaming kernels used by SimdMandelbrotCalculator.
+// Each kernel evaluates pixels [begin, end) and writes iteration counts to data[p].
+// The intrinsic kernels refill a lane as soon as its pixel escapes (or hits maxIter),
+// so a slow interior pixel no longer keeps the other lanes of its batch idle.
+using SimdKernel = void (*)(const SimdView &view, unsigned begin, unsigned end, int *data);
+
+// Same streaming over an explicit list of pixels instead of a range: evaluates
+// pixels[0, count) and writes data[pixels[i]]. Lets the boundary tracing of
+// BorderMandelbrotCalculator feed the pixels it needs to the vector kernels.
+using SimdListKernel = void (*)(const SimdView &view, const unsigned *pixels, unsigned count, int *data);
+
+// With derivativeEps set, every lane also carries dz/dz0 and retires at maxIter once
+// it drops below the threshold (see DerivativeEscapeRadius).
+
+// Each kernel comes in a double and a float flavour. The float one fits twice the
+// lanes per instruction and is only used while float resolves the pixel step
+// (see ZoomMandelbrotCalculator::isFloatPrecisionSufficient).
+
+// Portable batch loop, relies on compiler auto-vectorization
+void simdKernelPortable(const SimdView &view, unsigned begin, unsigned end, int *data);
+void simdKernelPortableFloat(const SimdView &view, unsigned begin, unsigned end, int *data);
+void simdListKernelPortable(const SimdView &view, const unsigned *pixels, unsigned count, int *data);
+
+// Double-double flavour for views below double resolution. Pixel p is
+// c = ref + (dminr + x * stepr, dmini + y * stepi), with the reference point split
+// in hi and lo parts. Uses the portable batch layout with hi and lo lanes.
+struct SimdViewDD
+{
+    double refrHi, refrLo;
+    double refiHi, refiLo;
+    double dminr, dmini;
+    double stepr, stepi;
+    int width;
+    double periodEps;     // As in SimdView
+    double derivativeEps; // As in SimdView
+    int maxIter;
+};
+
+void simdKernelPortableDD(const SimdViewDD &view, unsigned begin, unsigned end, int *data);
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIMD_KERNELS_X86 1
+// Hand-written intrinsic kernels, compiled in their own translation units
+// with the matching ISA flags (see Makefile). Only call them after checking
+// the CPU supports the instruction set.
+void simdKernelAvx2(const SimdView &view, unsigned begin, unsigned end, int *data);        // 4 x double
+void simdKernelAvx2Float(const SimdView &view, unsigned begin, unsigned end, int *data);   // 8 x float
+void simdKernelAvx512(const SimdView &view, unsigned begin, unsigned end, int *data);      // 8 x double
+void simdKernelAvx512Float(const SimdView &view, unsigned begin, unsigned end, int *data); // 16 x float
+void simdListKernelAvx2(const SimdView &view, const unsigned *pixels, unsigned count, int *data);
+void simdListKernelAvx512(const SimdView &view, const unsigned *pixels, unsigned count, int *data);
+#endif
+
+struct SimdKernels
+{
+    SimdKernel f64;
+    SimdKernel f32;
+    SimdListKernel f64List;
+    const char *name; // Short label for verbose output
+};
+
+// Picks the widest kernels supported by the running CPU (checked once via cpuid)
+const SimdKernels &selectSimdKernels();
@@ -0,0 +1,278 @@
+#include "simd_kernels.h"
+#include "mandelbrot_calculator.h"
+#include "interior_check.h"
+
+// This file is compiled with -mavx512f -mavx512dq on x86-64 (see Makefile)
+#if defined(SIMD_KERNELS_X86) && defined(__AVX512F__)
+#include <immintrin.h>
+#include <limits>
+
+namespace
+{
+// 512-bit lane types. Comparisons produce a mask register, one bit per lane.
+struct F64x8
+{
+    using Scalar = double;
+    using Reg = __m512d;
+    using Mask = __mmask8;
+    static constexpr int LANES = 8;
+
+    static Reg load(const Scalar *p) { return _mm512_load_pd(p); }
+    static void store(Scalar *p, Reg v) { _mm512_store_pd(p, v); }
+    static Reg set1(Scalar x) { return _mm512_set1_pd(x); }
+    static Reg add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+    static Reg abs(Reg a) { return _mm512_abs_pd(a); }
+    static Mask ge(Reg a, Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+    static Mask lt(Reg a, Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static Mask eq(Reg a, Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static Reg select(Mask m, Reg a, Reg b) { return _mm512_mask_blend_pd(m, b, a); }
+    static unsigned bits(Mask m) { return m; }
+};
+
+struct F32x16
+{
+    using Scalar = float;
+    using Reg = __m512;
+    using Mask = __mmask16;
+    static constexpr int LANES = 16;
+
+    static Reg load(const Scalar *p) { return _mm512_load_ps(p); }
+    static void store(Scalar *p, Reg v) { _mm512_store_ps(p, v); }
+    static Reg set1(Scalar x) { return _mm512_set1_ps(x); }
+    static Reg add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+    static Reg abs(Reg a) { return _mm512_abs_ps(a); }
+    static Mask ge(Reg a, Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+    static Mask lt(Reg a, Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static Mask eq(Reg a, Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static Reg select(Mask m, Reg a, Reg b) { return _mm512_mask_blend_ps(m, b, a); }
+    static unsigned bits(Mask m) { return m; }
+};
+
+// Pixels a kernel call evaluates: a range [begin, end) or an explicit list
+struct PixelRange
+{
+    unsigned next, end;
+
+    bool pop(unsigned &p)
+    {
+        if (next == end)
+            return false;
+        p = next++;
+        return true;
+    }
+};
+
+struct PixelList
+{
+    const unsigned *pixels;
+    unsigned next, count;
+
+    bool pop(unsigned &p)
+    {
+        if (next == count)
+            return false;
+        p = pixels[next++];
+        return true;
+    }
+};
+
+// PERIODIC enables Brent cycle detection (see EscapeKernel::iterate), DERIVATIVE
+// the dz/dz0 accumulator of derivative interior detection (see DerivativeEscapeRadius)
+template <class V, bool PERIODIC, bool DERIVATIVE, class Pixels>
+void streamPixels(const SimdView &view, Pixels pixels, int *data)
+{
+    using T = typename V::Scalar;
+    constexpr int LANES = V::LANES;
+    // Idle lanes sit at z = c = 0 with a count that can never reach maxIter
+    constexpr T IDLE = std::numeric_limits<T>::lowest();
+
+    const typename V::Reg four = V::set1(4);
+    const typename V::Reg one = V::set1(1);
+    const typename V::Reg maxIter = V::set1(view.maxIter);
+    const typename V::Reg periodEps = V::set1(static_cast<T>(view.periodEps));
+    const typename V::Reg derivativeEps = V::set1(static_cast<T>(view.derivativeEps));
+
+    // Lane state lives in these arrays while lanes are being refilled
+    alignas(64) T cr[LANES], ci[LANES], zr[LANES], zi[LANES], iters[LANES];
+    // Orbit point saved for periodicity checking and the iteration of the next save
+    alignas(64) T sr[LANES], si[LANES], saveAt[LANES];
+    // dz/dz0 of each lane
+    alignas(64) T dr[LANES], di[LANES];
+    int pixel[LANES];
+
+    int busy = 0;
+
+    auto fill = [&](int lane)
+    {
+        unsigned p;
+        while (pixels.pop(p))
+        {
+            // Same coordinate formula as the scalar engines (minr + x * stepr),
+            // evaluated in double before narrowing to the lane type
+            double x = view.minr + (p % view.width) * view.stepr;
+            double y = view.mini + (p / view.width) * view.stepi;
+
+            // Cardioid and bulb pixels are settled here and never take a lane
+            if (isInMainCardioidOrBulb(x, y))
+            {
+                data[p] = view.maxIter;
+                continue;
+            }
+
+            cr[lane] = static_cast<T>(x);
+            ci[lane] = static_cast<T>(y);
+            zr[lane] = sr[lane] = cr[lane];
+            zi[lane] = si[lane] = ci[lane];
+            iters[lane] = 0;
+            saveAt[lane] = 1;
+            dr[lane] = 1;
+            di[lane] = 0;
+            pixel[lane] = p;
+            ++busy;
+            return;
+        }
+
+        cr[lane] = ci[lane] = zr[lane] = zi[lane] = 0;
+        // Saved point away from the fixed point 0 so the idle lane never "repeats"
+        sr[lane] = si[lane] = 1;
+        saveAt[lane] = 0;
+        // NaN derivative: never below the threshold, where z = 0 would make it 0
+        dr[lane] = di[lane] = std::numeric_limits<T>::quiet_NaN();
+        iters[lane] = IDLE;
+        pixel[lane] = -1;
+    };
+
+    for (int lane = 0; lane < LANES; ++lane)
+        fill(lane);
+
+    while (busy > 0)
+    {
+        typename V::Reg vcr = V::load(cr);
+        typename V::Reg vci = V::load(ci);
+        typename V::Reg vzr = V::load(zr);
+        typename V::Reg vzi = V::load(zi);
+        typename V::Reg viters = V::load(iters);
+        typename V::Reg vsr, vsi, vsaveAt;
+        if constexpr (PERIODIC)
+        {
+            vsr = V::load(sr);
+            vsi = V::load(si);
+            vsaveAt = V::load(saveAt);
+        }
+        typename V::Reg vdr, vdi;
+        if constexpr (DERIVATIVE)
+        {
+            vdr = V::load(dr);
+            vdi = V::load(di);
+        }
+        unsigned finished;
+
+        // Iterate in registers until at least one lane escapes or runs out of iterations
+        for (;;)
+        {
+            typename V::Reg r2 = V::mul(vzr, vzr);
+            typename V::Reg i2 = V::mul(vzi, vzi);
+
+            finished = V::bits(V::ge(V::add(r2, i2), four)) | V::bits(V::ge(viters, maxIter));
+            if (finished)
+                break;
+
+            if constexpr (DERIVATIVE)
+            {
+                // dz/dz0 <- 2 z dz/dz0, from the z before the step. An attracted lane
+                // jumps to maxIter like a repeating one.
+                typename V::Reg nr = V::sub(V::mul(vzr, vdr), V::mul(vzi, vdi));
+                typename V::Reg ni = V::add(V::mul(vzr, vdi), V::mul(vzi, vdr));
+                vdr = V::add(nr, nr);
+                vdi = V::add(ni, ni);
+                typename V::Reg norm = V::add(V::mul(vdr, vdr), V::mul(vdi, vdi));
+                viters = V::select(V::lt(norm, derivativeEps), V::sub(maxIter, one), viters);
+            }
+
+            typename V::Reg ri = V::mul(vzr, vzi);
+            vzi = V::add(V::add(ri, ri), vci);
+            vzr = V::add(V::sub(r2, i2), vcr);
+
+            if constexpr (PERIODIC)
+            {
+                // A repeating lane jumps to maxIter and retires on the next check
+                typename V::Reg dist = V::add(V::abs(V::sub(vzr, vsr)), V::abs(V::sub(vzi, vsi)));
+                viters = V::select(V::lt(dist, periodEps), V::sub(maxIter, one), viters);
+
+                typename V::Mask save = V::eq(viters, vsaveAt);
+                vsr = V::select(save, vzr, vsr);
+                vsi = V::select(save, vzi, vsi);
+                vsaveAt = V::select(save, V::add(vsaveAt, vsaveAt), vsaveAt);
+            }
+
+            viters = V::add(viters, one);
+        }
+
+        V::store(zr, vzr);
+        V::store(zi, vzi);
+        V::store(iters, viters);
+        if constexpr (PERIODIC)
+        {
+            V::store(sr, vsr);
+            V::store(si, vsi);
+            V::store(saveAt, vsaveAt);
+        }
+        if constexpr (DERIVATIVE)
+        {
+            V::store(dr, vdr);
+            V::store(di, vdi);
+        }
+
+        // Retire finished lanes and load the next pending pixels into them
+        for (int lane = 0; lane < LANES; ++lane)
+        {
+            if (!(finished & (1u << lane)))
+                continue;
+            data[pixel[lane]] = static_cast<int>(iters[lane]);
+            --busy;
+            fill(lane);
+        }
+    }
+}
+
+// Instantiation for the interior checks the view enables
+template <class V, class Pixels>
+void dispatch(const SimdView &view, Pixels pixels, int *data)
+{
+    if (view.derivativeEps > 0.0)
+    {
+        if (view.periodEps > 0.0)
+            streamPixels<V, true, true>(view, pixels, data);
+        else
+            streamPixels<V, false, true>(view, pixels, data);
+    }
+    else
+    {
+        if (view.periodEps > 0.0)
+            streamPixels<V, true, false>(view, pixels, data);
+        else
+            streamPixels<V, false, false>(view, pixels, data);
+    }
+}
+} // namespace
+
+void simdKernelAvx512(const SimdView &view, unsigned begin, unsigned end, int *data)
+{
+    dispatch<F64x8>(view, PixelRange{begin, end}, data);
+}
+
+void simdKernelAvx512Float(const SimdView &view, unsigned begin, unsigned end, int *data)
+{
+    dispatch<F32x16>(view, PixelRange{begin, end}, data);
+}
+
+void simdListKernelAvx512(const SimdView &view, const unsigned *pixels, unsigned count, int *data)
+{
+    dispatch<F64x8>(view, PixelList{pixels, 0, count}, data);
+}
+
+#endif
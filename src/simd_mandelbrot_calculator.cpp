@@ -1,113 +1,346 @@
 #include "simd_mandelbrot_calculator.h"
+#include "simd_kernels.h"
+#include "escape_kernel.h"
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <string>
 
-SimdMandelbrotCalculator::SimdMandelbrotCalculator(int w, int h)
-    : StorageMandelbrotCalculator(w, h)
+template <class T, bool PERIODIC, class Bailout, class Limit>
+static void simdBatchPortable(const SimdView &view, unsigned begin, unsigned end, int *data, Limit maxIter,
+                              const Bailout &bailout)
 {
+    // Batch size for SIMD.
+    // AVX2 processes 4 doubles (256 bits). AVX-512 processes 8 doubles (512 bits).
+    // 8 is a good number to unroll loops for.
+    // Unlike the intrinsic kernels this one does not refill lanes: without explicit
+    // vector registers the scalar refill bookkeeping costs more than idle lanes.
+    constexpr int BATCH_SIZE = 8;
+    using Kernel = EscapeKernel<T, BATCH_SIZE, MandelbrotFormula<>, Bailout, PERIODIC>;
+
+    for (unsigned p = begin; p < end; p += BATCH_SIZE)
+    {
+        int current_batch_size = std::min<unsigned>(BATCH_SIZE, end - p);
+
+        alignas(64) T cr[BATCH_SIZE];
+        alignas(64) T ci[BATCH_SIZE];
+        for (int i = 0; i < current_batch_size; ++i)
+        {
+            cr[i] = static_cast<T>(view.minr + ((p + i) % view.width) * view.stepr);
+            ci[i] = static_cast<T>(view.mini + ((p + i) / view.width) * view.stepi);
+        }
+
+        Kernel::iterateBatch(cr, ci, current_batch_size, maxIter, view.periodEps, data + p,
+                             MandelbrotFormula<>(), bailout);
+    }
 }
 
-void SimdMandelbrotCalculator::compute(std::function<void()> progressCallback)
+template <class T, bool PERIODIC, class Bailout>
+static void simdBatchPortable(const SimdView &view, unsigned begin, unsigned end, int *data, const Bailout &bailout)
+{
+    // The default budget gets its own instantiation with the loop bound known at
+    // compile time, any other goes through the runtime value
+    using DefaultLimit = std::integral_constant<int, MandelbrotCalculator::DEFAULT_MAX_ITER>;
+    if (view.maxIter == DefaultLimit::value)
+        simdBatchPortable<T, PERIODIC>(view, begin, end, data, DefaultLimit(), bailout);
+    else
+        simdBatchPortable<T, PERIODIC>(view, begin, end, data, view.maxIter, bailout);
+}
+
+// Instantiation for the interior checks the view enables
+template <class T>
+static void simdBatchPortable(const SimdView &view, unsigned begin, unsigned end, int *data)
+{
+    const DerivativeEscapeRadius derivative(view.derivativeEps);
+    if (view.derivativeEps > 0.0)
+    {
+        if (view.periodEps > 0.0)
+            simdBatchPortable<T, true>(view, begin, end, data, derivative);
+        else
+            simdBatchPortable<T, false>(view, begin, end, data, derivative);
+    }
+    else
+    {
+        if (view.periodEps > 0.0)
+            simdBatchPortable<T, true>(view, begin, end, data, EscapeRadius());
+        else
+            simdBatchPortable<T, false>(view, begin, end, data, EscapeRadius());
+    }
+}
+
+void simdKernelPortable(const SimdView &view, unsigned begin, unsigned end, int *data)
+{
+    simdBatchPortable<double>(view, begin, end, data);
+}
+
+void simdKernelPortableFloat(const SimdView &view, unsigned begin, unsigned end, int *data)
+{
+    simdBatchPortable<float>(view, begin, end, data);
+}
+
+template <bool PERIODIC, class Bailout>
+static void simdListPortable(const SimdView &view, const unsigned *pixels, unsigned count, int *data,
+                             const Bailout &bailout)
 {
-    // Batch size for SIMD. 
-    // AVX2 processes 4 doubles (256 bits). AVX-512 processes 8 doubles (512 bits).
-    // 8 is a good number to unroll loops for.
     constexpr int BATCH_SIZE = 8;
+    using Kernel = EscapeKernel<double, BATCH_SIZE, MandelbrotFormula<>, Bailout, PERIODIC>;
+
+    for (unsigned p = 0; p < count; p += BATCH_SIZE)
+    {
+        int current_batch_size = std::min<unsigned>(BATCH_SIZE, count - p);
+
+        alignas(64) double cr[BATCH_SIZE];
+        alignas(64) double ci[BATCH_SIZE];
+        alignas(64) int values[BATCH_SIZE];
+        for (int i = 0; i < current_batch_size; ++i)
+        {
+            cr[i] = view.minr + (pixels[p + i] % view.width) * view.stepr;
+            ci[i] = view.mini + (pixels[p + i] / view.width) * view.stepi;
+        }
+
+        Kernel::iterateBatch(cr, ci, current_batch_size, view.maxIter, view.periodEps, values,
+                             MandelbrotFormula<>(), bailout);
+
+        for (int i = 0; i < current_batch_size; ++i)
+            data[pixels[p + i]] = values[i];
+    }
+}
+
+void simdListKernelPortable(const SimdView &view, const unsigned *pixels, unsigned count, int *data)
+{
+    const DerivativeEscapeRadius derivative(view.derivativeEps);
+    if (view.derivativeEps > 0.0)
+    {
+        if (view.periodEps > 0.0)
+            simdListPortable<true>(view, pixels, count, data, derivative);
+        else
+            simdListPortable<false>(view, pixels, count, data, derivative);
+    }
+    else
+    {
+        if (view.periodEps > 0.0)
+            simdListPortable<true>(view, pixels, count, data, EscapeRadius());
+        else
+            simdListPortable<false>(view, pixels, count, data, EscapeRadius());
+    }
+}
 
-    unsigned processed = 0;
+template <bool PERIODIC, class Bailout>
+static void simdBatchPortableDD(const SimdViewDD &view, unsigned begin, unsigned end, int *data,
+                                const Bailout &bailout)
+{
+    // Same batch layout as EscapeKernel::iterateBatch with every value split in hi
+    // and lo lanes. The DoubleDouble operators inline to plain lane-wise arithmetic;
+    // arrays of DoubleDouble would interleave hi and lo and defeat vectorization.
+    // No cardioid shortcut, as in the double-double engine: the test runs in double
+    // and the views this kernel gets sit right on the boundary it would misjudge.
+    constexpr int BATCH_SIZE = 8;
+    const int maxIter = view.maxIter;
+    const double periodEps = view.periodEps;
+    const DoubleDouble refr(view.refrHi, view.refrLo);
+    const DoubleDouble refi(view.refiHi, view.refiLo);
 
-    for (int y = 0; y < height; ++y)
+    for (unsigned p = begin; p < end; p += BATCH_SIZE)
     {
-        double cy = mini + y * stepi;
-        
-        for (int x = 0; x < width; x += BATCH_SIZE)
+        int current_batch_size = std::min<unsigned>(BATCH_SIZE, end - p);
+
+        alignas(64) double crh[BATCH_SIZE], crl[BATCH_SIZE];
+        alignas(64) double cih[BATCH_SIZE], cil[BATCH_SIZE];
+        alignas(64) double zrh[BATCH_SIZE], zrl[BATCH_SIZE];
+        alignas(64) double zih[BATCH_SIZE], zil[BATCH_SIZE];
+        alignas(64) long long iters[BATCH_SIZE];
+        alignas(64) long long mask[BATCH_SIZE]; // 1 if active, 0 if done
+        // Orbit point saved for periodicity checking and the iteration of the next save
+        alignas(64) double srh[BATCH_SIZE], srl[BATCH_SIZE];
+        alignas(64) double sih[BATCH_SIZE], sil[BATCH_SIZE];
+        alignas(64) long long saveAt[BATCH_SIZE];
+        // dz/dz0 in plain double: the derivative is a ratio, the hi parts of z
+        // resolve it as well as the double kernels do
+        alignas(64) double dr[BATCH_SIZE], di[BATCH_SIZE];
+
+        for (int i = 0; i < BATCH_SIZE; ++i)
+        {
+            unsigned q = p + ((i < current_batch_size) ? i : 0);
+
+            DoubleDouble cr = refr + DoubleDouble(view.dminr + (q % view.width) * view.stepr);
+            DoubleDouble ci = refi + DoubleDouble(view.dmini + (q / view.width) * view.stepi);
+            crh[i] = zrh[i] = srh[i] = cr.hi;
+            crl[i] = zrl[i] = srl[i] = cr.lo;
+            cih[i] = zih[i] = sih[i] = ci.hi;
+            cil[i] = zil[i] = sil[i] = ci.lo;
+            saveAt[i] = 1;
+            dr[i] = 1.0;
+            di[i] = 0.0;
+            iters[i] = 0;
+            mask[i] = (i < current_batch_size) ? 1 : 0;
+        }
+
+        for (int k = 0; k < maxIter; ++k)
         {
-            int current_batch_size = std::min(BATCH_SIZE, width - x);
-            
-            // Arrays for batch processing
-            // Use 64-bit integers for mask and iters to match double width (helps vectorization)
-            alignas(64) double cr[BATCH_SIZE];
-            alignas(64) double ci[BATCH_SIZE];
-            alignas(64) double zr[BATCH_SIZE];
-            alignas(64) double zi[BATCH_SIZE];
-            alignas(64) long long iters[BATCH_SIZE];
-            alignas(64) long long mask[BATCH_SIZE]; // 1 if active, 0 if escaped
-
-            // Initialize batch
-            // We initialize all BATCH_SIZE elements to ensure the loop size is constant
-            // For elements beyond width, we just duplicate the last valid coordinate or use 0
-            // This avoids branches in initialization
             for (int i = 0; i < BATCH_SIZE; ++i)
             {
-                // Use a safe index for calculation to avoid branching
-                // If i >= current_batch_size, we just compute a dummy value (e.g. 0,0)
-                // We won't save it anyway.
-                int offset = (i < current_batch_size) ? i : 0;
-                
-                cr[i] = minr + (x + offset) * stepr;
-                ci[i] = cy;
-                zr[i] = cr[i];
-                zi[i] = ci[i];
-                iters[i] = 0;
-                // Mask is 0 for padding elements so they don't keep iterating
-                mask[i] = (i < current_batch_size) ? 1 : 0;
-            }
+                DoubleDouble zr(zrh[i], zrl[i]);
+                DoubleDouble zi(zih[i], zil[i]);
 
-            // Main iteration loop
-            for (int k = 0; k < MAX_ITER; ++k)
-            {
-                // Branchless inner loop for better auto-vectorization
-                // The compiler should unroll this and use SIMD instructions
-                for (int i = 0; i < BATCH_SIZE; ++i)
+                DoubleDouble r2 = zr * zr;
+                DoubleDouble i2 = zi * zi;
+                DoubleDouble ri = zr * zi;
+
+                DoubleDouble next_zi = ri + ri + DoubleDouble(cih[i], cil[i]);
+                DoubleDouble next_zr = r2 - i2 + DoubleDouble(crh[i], crl[i]);
+
+                // Every stop condition is settled before any lane state is
+                // selected: testing the mask in between lets the compiler thread
+                // jumps through the loop body, which then no longer vectorizes
+                bool escaped = (r2.hi + i2.hi >= 4.0);
+                long long active = mask[i] & (!escaped);
+                long long inside = 0;
+
+                if constexpr (TracksDerivative<Bailout>)
                 {
-                    double r2 = zr[i] * zr[i];
-                    double i2 = zi[i] * zi[i];
-                    double ri = zr[i] * zi[i];
-
-                    // Calculate next values
-                    double next_zr = r2 - i2 + cr[i];
-                    double next_zi = ri + ri + ci[i];
-
-                    // Check escape condition
-                    bool escaped = (r2 + i2 >= 4.0);
-                    
-                    // Update mask: if already inactive (0) or escaped (true), result is 0
-                    mask[i] = mask[i] & (!escaped);
-
-                    // Update Z values only if still active
-                    zr[i] = mask[i] ? next_zr : zr[i];
-                    zi[i] = mask[i] ? next_zi : zi[i];
-                    
-                    // Increment iteration count if active
-                    iters[i] += mask[i];
+                    // Derivative of the same step. Stored unconditionally, a lane
+                    // that stopped never reads it again.
+                    bailout.track(dr[i], di[i], zrh[i], zih[i]);
+
+                    // An attracted lane is inside the set: stop it at maxIter
+                    inside = active & bailout.attracted(dr[i], di[i]);
+                    active = active & !inside;
                 }
 
-                // Check if any lanes are still active
-                // We do this outside the vector loop to avoid breaking vectorization
-                long long active_lanes = 0;
-                for (int i = 0; i < BATCH_SIZE; ++i)
+                if constexpr (PERIODIC)
                 {
-                    active_lanes |= mask[i];
+                    // A repeating orbit is inside the set: stop the lane at maxIter.
+                    // Close orbit points have equal leading bits, so the hi
+                    // difference is exact and the lo parts supply the rest.
+                    double dist = std::abs((next_zr.hi - srh[i]) + (next_zr.lo - srl[i])) +
+                                  std::abs((next_zi.hi - sih[i]) + (next_zi.lo - sil[i]));
+                    long long repeat = active & (dist < periodEps);
+                    inside = inside | repeat;
+                    active = active & !repeat;
                 }
 
-                if (active_lanes == 0)
-                    break;
+                zrh[i] = active ? next_zr.hi : zrh[i];
+                zrl[i] = active ? next_zr.lo : zrl[i];
+                zih[i] = active ? next_zi.hi : zih[i];
+                zil[i] = active ? next_zi.lo : zil[i];
+
+                long long iter = inside ? maxIter : iters[i];
+
+                if constexpr (PERIODIC)
+                {
+                    long long save = active & (iter == saveAt[i]);
+                    srh[i] = save ? next_zr.hi : srh[i];
+                    srl[i] = save ? next_zr.lo : srl[i];
+                    sih[i] = save ? next_zi.hi : sih[i];
+                    sil[i] = save ? next_zi.lo : sil[i];
+                    saveAt[i] = save ? saveAt[i] * 2 : saveAt[i];
+                }
+
+                mask[i] = active;
+                iters[i] = iter + active;
             }
 
-            // Store results
-            for (int i = 0; i < current_batch_size; ++i)
+            long long active_lanes = 0;
+            for (int i = 0; i < BATCH_SIZE; ++i)
             {
-                data[y * width + x + i] = iters[i];
+                active_lanes |= mask[i];
             }
-            
-            processed += current_batch_size;
+
+            if (active_lanes == 0)
+                break;
         }
 
-        if (!speedMode && processed % (width * 10) < BATCH_SIZE)
+        for (int i = 0; i < current_batch_size; ++i)
         {
-            if (progressCallback)
-                progressCallback();
+            data[p + i] = iters[i];
         }
     }
+}
 
+void simdKernelPortableDD(const SimdViewDD &view, unsigned begin, unsigned end, int *data)
+{
+    const DerivativeEscapeRadius derivative(view.derivativeEps);
+    if (view.derivativeEps > 0.0)
+    {
+        if (view.periodEps > 0.0)
+            simdBatchPortableDD<true>(view, begin, end, data, derivative);
+        else
+            simdBatchPortableDD<false>(view, begin, end, data, derivative);
+    }
+    else
+    {
+        if (view.periodEps > 0.0)
+            simdBatchPortableDD<true>(view, begin, end, data, EscapeRadius());
+        else
+            simdBatchPortableDD<false>(view, begin, end, data, EscapeRadius());
+    }
+}
+
+const SimdKernels &selectSimdKernels()
+{
+    // Resolved once per process: the render hosts differ in ISA,
+    // so the choice is made at runtime instead of at build time
+    static const SimdKernels selection = []() -> SimdKernels
+    {
+#ifdef SIMD_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+            return {simdKernelAvx512, simdKernelAvx512Float, simdListKernelAvx512, "avx512"};
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return {simdKernelAvx2, simdKernelAvx2Float, simdListKernelAvx2, " avx2"};
+#endif
+        return {simdKernelPortable, simdKernelPortableFloat, simdListKernelPortable, " simd"};
+    }();
+
+    return selection;
+}
+
+SimdMandelbrotCalculator::SimdMandelbrotCalculator(int w, int h)
+    : StorageMandelbrotCalculator(w, h), kernels(selectSimdKernels()), usedFloat(false), usedDoubleDouble(false)
+{
+}
+
+void SimdMandelbrotCalculator::compute(std::function<void()> progressCallback)
+{
+    const SimdView view = {minr, mini, stepr, stepi, width, periodicityEpsilon(), derivativeEpsilon(), maxIter};
+    const DoubleDouble refrDD = refr.toDoubleDouble();
+    const DoubleDouble refiDD = refi.toDoubleDouble();
+    const SimdViewDD viewDD = {refrDD.hi, refrDD.lo, refiDD.hi, refiDD.lo, dminr, dmini, stepr, stepi, width,
+                               view.periodEps, view.derivativeEps, maxIter};
+    const unsigned total = width * height;
+
+    // Stream the whole tile through the kernel in one go in speed mode,
+    // otherwise in chunks of 10 lines so the display can update in between
+    const unsigned chunk = speedMode ? total : width * 10;
+
+    // Shallow views get the float kernel (twice the lanes), deeper ones need double,
+    // and views below double resolution the double-double one
+    usedFloat = isFloatPrecisionSufficient();
+    usedDoubleDouble = !isDoublePrecisionSufficient();
+    SimdKernel kernel = usedFloat ? kernels.f32 : kernels.f64;
+
+    for (unsigned begin = 0; begin < total; begin += chunk)
+    {
+        unsigned end = std::min(begin + chunk, total);
+        if (usedDoubleDouble)
+            simdKernelPortableDD(viewDD, begin, end, data.data());
+        else
+            kernel(view, begin, end, data.data());
+
+        if (!speedMode && progressCallback)
+            progressCallback();
+    }
+}
+
+FloatExp SimdMandelbrotCalculator::getMinDiam() const
+{
+    // Deep views switch to the double-double kernel
+    return DoubleDouble::EPSILON * 1e6;
+}
+
+std::string SimdMandelbrotCalculator::getEngineName() const
+{
+    if (usedDoubleDouble)
+        return std::string(kernels.name) + "/dd";
+    return std::string(kernels.name) + (usedFloat ? "/f32" : "");
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "storage_mandelbrot_calculator.h"
+#include "simd_kernels.h"
 
 class SimdMandelbrotCalculator : public StorageMandelbrotCalculator
 {
@@ -8,6 +9,16 @@ public:
     SimdMandelbrotCalculator(int width, int height);
 
     void compute(std::function<void()> progressCallback) override;
-    
-    std::string getEngineName() const override { return " simd"; }
+
+    // Reports the instruction set picked at runtime (avx512, avx2 or portable simd)
+    // and whether the last frame ran in single or double-double precision
+    std::string getEngineName() const override;
+
+    // Limited by double-double instead of double
+    FloatExp getMinDiam() const override;
+
+private:
+    const SimdKernels &kernels;
+    bool usedFloat;
+    bool usedDoubleDouble;
 };
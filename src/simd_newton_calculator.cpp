@@ -0,0 +1,108 @@
+#include "simd_newton_calculator.h"
+#include "escape_kernel.h"
+#include <algorithm>
+#include <format>
+
+SimdNewtonCalculator::SimdNewtonCalculator(int w, int h)
+    : StorageMandelbrotCalculator(w, h),
+      polynomial(std::make_shared<const NewtonPolynomial>(NewtonPolynomial::parse("z^3-1")))
+{
+}
+
+void SimdNewtonCalculator::setPolynomial(std::shared_ptr<const NewtonPolynomial> p)
+{
+    polynomial = std::move(p);
+}
+
+template <class Formula, class Bailout>
+void SimdNewtonCalculator::computeWith(const Formula &formula, const Bailout &bailout,
+                                       std::function<void()> progressCallback)
+{
+    // Newton points converge in a few iterations and neighbours in about as many,
+    // so wide batches waste few lanes and keep several vector divisions in flight
+    // (32 lanes ran 3x faster than 8)
+    constexpr int BATCH_SIZE = 32;
+    using Kernel = EscapeKernel<double, BATCH_SIZE, Formula, Bailout, false>;
+
+    const unsigned total = width * height;
+    // Whole tile in one go in speed mode, otherwise chunks of 10 lines so the
+    // display can update in between
+    const unsigned chunk = speedMode ? total : width * 10;
+
+    for (unsigned begin = 0; begin < total; begin += chunk)
+    {
+        unsigned end = std::min(begin + chunk, total);
+        for (unsigned p = begin; p < end; p += BATCH_SIZE)
+        {
+            int count = std::min<unsigned>(BATCH_SIZE, end - p);
+
+            alignas(64) double cr[BATCH_SIZE];
+            alignas(64) double ci[BATCH_SIZE];
+            for (int i = 0; i < count; ++i)
+            {
+                cr[i] = minr + ((p + i) % width) * stepr;
+                ci[i] = mini + ((p + i) / width) * stepi;
+            }
+
+            Kernel::iterateBatch(cr, ci, count, maxIter, 0.0, data.data() + p, formula, bailout);
+        }
+
+        if (!speedMode && progressCallback)
+            progressCallback();
+    }
+}
+
+template <int DEGREE>
+void SimdNewtonCalculator::computeDegree(std::function<void()> progressCallback)
+{
+    // One band of the palette per root, see NearestRootConvergence
+    computeWith(PolynomialNewtonFormula<DEGREE>(*polynomial), NearestRootConvergence{*polynomial},
+                progressCallback);
+}
+
+void SimdNewtonCalculator::compute(std::function<void()> progressCallback)
+{
+    // The closed form step and the fixed roots of z^3 - 1 run about twice as fast as
+    // the Horner step and the root grid, with the roots in the same order (the
+    // shading moves by a few steps: NewtonCubicFormula's roots are rounded)
+    const std::vector<double> cubic = {1, 0, 0, -1};
+    if (polynomial->getCoefficients() == cubic)
+    {
+        computeWith(NewtonCubicFormula(), RootConvergence<NewtonCubicFormula>(), progressCallback);
+        return;
+    }
+
+    static_assert(MAX_UNROLLED_DEGREE == 8, "one case per unrolled degree below");
+    switch (polynomial->getDegree())
+    {
+    case 2:
+        computeDegree<2>(progressCallback);
+        break;
+    case 3:
+        computeDegree<3>(progressCallback);
+        break;
+    case 4:
+        computeDegree<4>(progressCallback);
+        break;
+    case 5:
+        computeDegree<5>(progressCallback);
+        break;
+    case 6:
+        computeDegree<6>(progressCallback);
+        break;
+    case 7:
+        computeDegree<7>(progressCallback);
+        break;
+    case 8:
+        computeDegree<8>(progressCallback);
+        break;
+    default:
+        computeDegree<0>(progressCallback);
+        break;
+    }
+}
+
+std::string SimdNewtonCalculator::getEngineName() const
+{
+    return std::format(" newton deg {}", polynomial->getDegree());
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "storage_mandelbrot_calculator.h"
+#include "newton_polynomial.h"
+#include <memory>
+
+// Newton fractal of a NewtonPolynomial (z^3 - 1 unless set) through the batch path of
+// EscapeKernel: pixels side by side in lanes the compiler vectorizes. Degrees up to 8
+// have their own kernel with the Horner loop unrolled, higher ones share a
+// runtime-degree kernel; z^3 - 1 itself keeps the closed-form NewtonCubicFormula.
+class SimdNewtonCalculator : public StorageMandelbrotCalculator
+{
+public:
+    SimdNewtonCalculator(int width, int height);
+
+    void compute(std::function<void()> progressCallback) override;
+
+    // Shared between the tiles of a grid
+    void setPolynomial(std::shared_ptr<const NewtonPolynomial> polynomial);
+
+    std::string getEngineName() const override;
+
+private:
+    // Highest degree with a compile-time kernel
+    static constexpr int MAX_UNROLLED_DEGREE = 8;
+
+    std::shared_ptr<const NewtonPolynomial> polynomial;
+
+    template <class Formula, class Bailout>
+    void computeWith(const Formula &formula, const Bailout &bailout,
+                     std::function<void()> progressCallback);
+    template <int DEGREE>
+    void computeDegree(std::function<void()> progressCallback);
+};
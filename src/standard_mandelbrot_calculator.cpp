@@ -1,4 +1,5 @@
 #include "standard_mandelbrot_calculator.h"
+#include "escape_kernel.h"
 #include <cmath>
 
 StandardMandelbrotCalculator::StandardMandelbrotCalculator(int w, int h)
@@ -6,38 +7,31 @@ StandardMandelbrotCalculator::StandardMandelbrotCalculator(int w, int h)
 {
 }
 
-int StandardMandelbrotCalculator::iterate(double x, double y)
-{
-    double r = x, i = y;
-    int iter;
-
-    for (iter = 0; iter < MAX_ITER; ++iter)
-    {
-        double r2 = r * r;
-        double i2 = i * i;
-
-        if (r2 + i2 >= 4.0)
-            break;
-
-        double ri = r * i;
-        i = ri + ri + y; // z = z^2 + c
-        r = r2 - i2 + x;
-    }
-
-    return iter;
-}
-
 void StandardMandelbrotCalculator::compute(std::function<void()> progressCallback)
 {
+    using Kernel = EscapeKernel<double, 1, MandelbrotFormula<>, EscapeRadius, false>;
+    using PeriodicKernel = EscapeKernel<double, 1, MandelbrotFormula<>, EscapeRadius, true>;
+    using DerivativeKernel = EscapeKernel<double, 1, MandelbrotFormula<>, DerivativeEscapeRadius, false>;
+    using PeriodicDerivativeKernel = EscapeKernel<double, 1, MandelbrotFormula<>, DerivativeEscapeRadius, true>;
+
     unsigned processed = 0;
-    
+    const double periodEps = periodicityEpsilon();
+    const DerivativeEscapeRadius derivative(derivativeEpsilon());
+    const MandelbrotFormula<> formula;
+
     for (int y = 0; y < height; ++y)
     {
         double cy = mini + y * stepi;
         for (int x = 0; x < width; ++x)
         {
             double cx = minr + x * stepr;
-            data[y * width + x] = iterate(cx, cy);
+            int &value = data[y * width + x];
+            if (derivative.threshold > 0.0)
+                value = periodEps > 0.0 ? PeriodicDerivativeKernel::iterate(cx, cy, maxIter, periodEps, formula, derivative)
+                                        : DerivativeKernel::iterate(cx, cy, maxIter, periodEps, formula, derivative);
+            else
+                value = periodEps > 0.0 ? PeriodicKernel::iterate(cx, cy, maxIter, periodEps)
+                                        : Kernel::iterate(cx, cy, maxIter, periodEps);
             processed++;
         }
 
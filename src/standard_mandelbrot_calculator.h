@@ -13,7 +13,4 @@ public:
     void compute(std::function<void()> progressCallback) override;
     
     std::string getEngineName() const override { return "  std"; }
-
-private:
-    int iterate(double x, double y);
 };
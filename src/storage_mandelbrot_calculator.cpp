@@ -4,10 +4,10 @@
 StorageMandelbrotCalculator::StorageMandelbrotCalculator(int w, int h)
     : ZoomMandelbrotCalculator(w, h)
 {
-    data.resize(width * height, MAX_ITER);
+    data.resize(width * height, maxIter);
 }
 
 void StorageMandelbrotCalculator::reset()
 {
-    std::fill(data.begin(), data.end(), MAX_ITER);
+    std::fill(data.begin(), data.end(), maxIter);
 }
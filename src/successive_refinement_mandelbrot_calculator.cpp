@@ -0,0 +1,134 @@
+#include "successive_refinement_mandelbrot_calculator.h"
+#include <algorithm>
+#include <cstring>
+
+SuccessiveRefinementMandelbrotCalculator::SuccessiveRefinementMandelbrotCalculator(int w, int h)
+    : StorageMandelbrotCalculator(w, h), kernels(selectSimdKernels()), view{}, pendingCount(0),
+      cellCols(0), cellRows(0)
+{
+}
+
+void SuccessiveRefinementMandelbrotCalculator::evaluate(unsigned p)
+{
+    pending[pendingCount++] = p;
+    if (pendingCount == CHUNK)
+        flush();
+}
+
+void SuccessiveRefinementMandelbrotCalculator::flush()
+{
+    if (pendingCount > 0)
+        kernels.f64List(view, pending, pendingCount, data.data());
+    pendingCount = 0;
+}
+
+void SuccessiveRefinementMandelbrotCalculator::markSolidCells(int cell)
+{
+    // Cells cut by the right or bottom edge have no far corners and are left out
+    cellCols = (width - 1) / cell;
+    cellRows = (height - 1) / cell;
+    cellValue.resize(cellCols * cellRows);
+    solid.assign(cellCols * cellRows, 0);
+
+    // Corner value of the cells whose four corners agree, UNIFORM_NONE otherwise
+    for (int j = 0; j < cellRows; ++j)
+    {
+        const int *top = data.data() + j * cell * width;
+        const int *bottom = top + cell * width;
+        for (int i = 0; i < cellCols; ++i)
+        {
+            const int x0 = i * cell, x1 = x0 + cell;
+            const int value = top[x0];
+            const bool uniform = top[x1] == value && bottom[x0] == value && bottom[x1] == value;
+            cellValue[j * cellCols + i] = uniform ? value : UNIFORM_NONE;
+        }
+    }
+
+    // A cell is guessed only when its neighbours have the same value too: four
+    // agreeing corners alone miss the filaments passing between them
+    for (int j = 0; j < cellRows; ++j)
+    {
+        for (int i = 0; i < cellCols; ++i)
+        {
+            const int value = cellValue[j * cellCols + i];
+            if (value == UNIFORM_NONE)
+                continue;
+            bool same = true;
+            for (int nj = std::max(0, j - 1); nj <= std::min(j + 1, cellRows - 1) && same; ++nj)
+                for (int ni = std::max(0, i - 1); ni <= std::min(i + 1, cellCols - 1); ++ni)
+                    if (cellValue[nj * cellCols + ni] != value)
+                    {
+                        same = false;
+                        break;
+                    }
+            solid[j * cellCols + i] = same;
+        }
+    }
+}
+
+void SuccessiveRefinementMandelbrotCalculator::refine(int step)
+{
+    const int cell = step * 2;
+    markSolidCells(cell);
+
+    // Guesses only read the corners of the coarser grid, which this level never
+    // writes, so evaluations can be deferred and batched
+    for (int y = 0; y < height; y += step)
+    {
+        // Rows of the coarser grid already hold every other point
+        const bool coarseRow = y % cell == 0;
+        const int j = y / cell;
+        for (int x = coarseRow ? step : 0; x < width; x += coarseRow ? cell : step)
+        {
+            const unsigned p = y * width + x;
+            const int i = x / cell;
+            if (i < cellCols && j < cellRows && solid[j * cellCols + i])
+                data[p] = cellValue[j * cellCols + i];
+            else
+                evaluate(p);
+        }
+    }
+    flush();
+}
+
+void SuccessiveRefinementMandelbrotCalculator::fillPreview(int step)
+{
+    for (int y = 0; y < height; y += step)
+    {
+        int *row = data.data() + y * width;
+        for (int x = 0; x < width; x += step)
+            std::fill_n(row + x + 1, std::min(step, width - x) - 1, row[x]);
+        for (int r = y + 1; r < std::min(y + step, height); ++r)
+            std::memcpy(data.data() + r * width, row, width * sizeof(int));
+    }
+}
+
+void SuccessiveRefinementMandelbrotCalculator::compute(std::function<void()> progressCallback)
+{
+    data.assign(width * height, 0);
+    view = {minr, mini, stepr, stepi, width, periodicityEpsilon(), derivativeEpsilon(), maxIter};
+    // Previews are only for the display (skip in speed mode)
+    const bool preview = !speedMode && progressCallback;
+
+    // First level: every grid point is evaluated
+    for (int y = 0; y < height; y += COARSE_STEP)
+        for (int x = 0; x < width; x += COARSE_STEP)
+            evaluate(y * width + x);
+    flush();
+    if (preview)
+    {
+        fillPreview(COARSE_STEP);
+        progressCallback();
+    }
+
+    for (int step = COARSE_STEP / 2; step >= 1; step /= 2)
+    {
+        refine(step);
+        if (preview)
+        {
+            if (step > 1)
+                fillPreview(step);
+            progressCallback();
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "storage_mandelbrot_calculator.h"
+#include "simd_kernels.h"
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+// Successive refinement: evaluates the image on a grid of every 16th pixel, then
+// halves the grid step down to 1. Each level keeps the pixels of the coarser ones
+// and only adds the new grid points; a new point inside a coarser cell whose four
+// corners agree, like those of the cells around it, takes their value without
+// being evaluated (solid guessing). In normal mode the display gets a blocky
+// preview of the whole image after each level.
+class SuccessiveRefinementMandelbrotCalculator : public StorageMandelbrotCalculator
+{
+public:
+    SuccessiveRefinementMandelbrotCalculator(int width, int height);
+
+    void compute(std::function<void()> progressCallback) override;
+
+    std::string getEngineName() const override { return "refine"; }
+
+private:
+    // Grid step of the first level, halved at each level down to single pixels
+    static constexpr int COARSE_STEP = 16;
+    // Pixels handed to the list kernel at once
+    static constexpr unsigned CHUNK = 4096;
+    // Cell value marking corners that disagree
+    static constexpr int UNIFORM_NONE = INT_MIN;
+
+    const SimdKernels &kernels;
+    SimdView view;
+    unsigned pending[CHUNK];
+    unsigned pendingCount;
+    // Cells of the coarser grid during a refinement, row-major
+    int cellCols, cellRows;
+    std::vector<int> cellValue;
+    std::vector<uint8_t> solid;
+
+    void evaluate(unsigned p);
+    void flush();
+    // Finds the cells of the grid with the given step that can be guessed
+    void markSolidCells(int cell);
+    // Evaluates or guesses the points added to the grid when its step goes
+    // from 2 * step down to step
+    void refine(int step);
+    // Spreads each grid point over its step x step block for the display
+    void fillPreview(int step);
+};
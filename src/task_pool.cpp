@@ -0,0 +1,85 @@
+#include "task_pool.h"
+#include <algorithm>
+
+TaskPool::TaskPool(unsigned numThreads) : running(0), stopping(false)
+{
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // The thread calling wait() is the last worker
+    for (unsigned t = 1; t < numThreads; ++t)
+        threads.emplace_back(&TaskPool::work, this);
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+void TaskPool::run(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+    // Lets a thread blocked in wait() help with it
+    idle.notify_one();
+}
+
+bool TaskPool::take(std::function<void()> &task, bool block)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (block)
+        wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+    if (tasks.empty())
+        return false;
+
+    // Newest first: a task's subtasks run while its data is still in cache
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    ++running;
+    return true;
+}
+
+void TaskPool::finish()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--running == 0 && tasks.empty())
+        idle.notify_all();
+}
+
+void TaskPool::work()
+{
+    std::function<void()> task;
+    while (take(task, true))
+    {
+        task();
+        finish();
+    }
+}
+
+void TaskPool::wait()
+{
+    std::function<void()> task;
+    for (;;)
+    {
+        while (take(task, false))
+        {
+            task();
+            finish();
+        }
+
+        // Nothing queued: done once the running tasks finish without queuing more
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return !tasks.empty() || running == 0; });
+        if (tasks.empty())
+            return;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running queued tasks. Tasks may queue more tasks;
+// wait() returns once the queue is empty and no task is running, and the waiting
+// thread runs tasks too instead of sleeping.
+class TaskPool
+{
+public:
+    // 0 threads: one per hardware thread, the caller of wait() included
+    explicit TaskPool(unsigned numThreads = 0);
+    ~TaskPool();
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake; // New task queued, or stopping
+    std::condition_variable idle; // Last task finished, or work for wait()
+    unsigned running;
+    bool stopping;
+
+    // Takes the next task, waiting for one while block is set. Returns false when
+    // there is none (or the pool stops).
+    bool take(std::function<void()> &task, bool block);
+    void finish();
+    void work();
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+// Per-thread work queue: the owner pushes and pops at the back, idle threads steal
+// from the front, the oldest items. Items move in batches so one lock covers many
+// of them and the owner rarely meets a thief on the same lock.
+template <class T>
+class WorkStealingDeque
+{
+public:
+    void push(const T *values, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.insert(items.end(), values, values + count);
+    }
+
+    // Moves up to max items from the back into out, returns how many
+    size_t pop(T *out, size_t max)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = std::min(max, items.size());
+        std::copy(items.end() - count, items.end(), out);
+        items.erase(items.end() - count, items.end());
+        return count;
+    }
+
+    // Moves up to max items, at most half of the queue, from the front into out
+    size_t steal(T *out, size_t max)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = std::min(max, (items.size() + 1) / 2);
+        std::copy(items.begin(), items.begin() + count, out);
+        items.erase(items.begin(), items.begin() + count);
+        return count;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<T> items;
+};
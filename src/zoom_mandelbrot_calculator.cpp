@@ -1,8 +1,10 @@
 #include "zoom_mandelbrot_calculator.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 ZoomMandelbrotCalculator::ZoomMandelbrotCalculator(int w, int h)
-    : width(w), height(h), speedMode(false)
+    : width(w), height(h), maxIter(DEFAULT_MAX_ITER), speedMode(false), periodicityCheck(false), derivativeCheck(false)
 {
     // Default initialization
     updateBounds(-0.5, 0.0, 3.0);
@@ -19,6 +21,12 @@ void ZoomMandelbrotCalculator::updateBounds(double new_cre, double new_cim, doub
     maxi = cim + diam * 0.5;
     stepr = (maxr - minr) / width;
     stepi = (maxi - mini) / height;
+
+    refr = cre;
+    refi = cim;
+    dminr = minr - cre;
+    dmini = mini - cim;
+    updateDeepBounds();
 }
 
 void ZoomMandelbrotCalculator::updateBoundsExplicit(double new_minr, double new_mini, double new_maxr, double new_maxi)
@@ -35,4 +43,119 @@ void ZoomMandelbrotCalculator::updateBoundsExplicit(double new_minr, double new_
     
     stepr = (maxr - minr) / width;
     stepi = (maxi - mini) / height;
+
+    refr = cre;
+    refi = cim;
+    dminr = minr - cre;
+    dmini = mini - cim;
+    updateDeepBounds();
+}
+
+void ZoomMandelbrotCalculator::updateDeepBounds()
+{
+    deepMinR = dminr;
+    deepMinI = dmini;
+    deepStepR = stepr;
+    deepStepI = stepi;
+    deepDiam = diam;
+}
+
+void ZoomMandelbrotCalculator::updateBoundsHP(const HighPrecision &new_cre, const HighPrecision &new_cim, FloatExp new_diam)
+{
+    FloatExp halfR = new_diam * FloatExp(0.5) * FloatExp(width) / FloatExp(height);
+    FloatExp halfI = new_diam * FloatExp(0.5);
+    updateBoundsRelative(new_cre, new_cim, -halfR, -halfI, halfR, halfI);
+}
+
+void ZoomMandelbrotCalculator::updateBoundsRelative(const HighPrecision &refR, const HighPrecision &refI,
+                                                    FloatExp new_minr, FloatExp new_mini, FloatExp new_maxr, FloatExp new_maxi)
+{
+    refr = refR;
+    refi = refI;
+    deepMinR = new_minr;
+    deepMinI = new_mini;
+
+    // Steps come from the relative bounds, which keep their precision at any depth
+    deepStepR = (new_maxr - new_minr) / FloatExp(width);
+    deepStepI = (new_maxi - new_mini) / FloatExp(height);
+    // Vertical extent, as passed to updateBounds
+    deepDiam = new_maxi - new_mini;
+
+    // Rounded to double, 0 below the double range
+    dminr = deepMinR.toDouble();
+    dmini = deepMinI.toDouble();
+    stepr = deepStepR.toDouble();
+    stepi = deepStepI.toDouble();
+
+    diam = deepDiam.toDouble();
+
+    double r = refr.toDouble();
+    double i = refi.toDouble();
+    minr = r + dminr;
+    mini = i + dmini;
+    maxr = r + new_maxr.toDouble();
+    maxi = i + new_maxi.toDouble();
+    cre = r + (new_minr + new_maxr).toDouble() / 2.0;
+    cim = i + (new_mini + new_maxi).toDouble() / 2.0;
+}
+
+HighPrecision ZoomMandelbrotCalculator::getCreHP() const
+{
+    return refr + HighPrecision(deepMinR + deepStepR * FloatExp(width / 2.0));
+}
+
+HighPrecision ZoomMandelbrotCalculator::getCimHP() const
+{
+    return refi + HighPrecision(deepMinI + deepStepI * FloatExp(height / 2.0));
+}
+
+bool ZoomMandelbrotCalculator::isPrecisionSufficient(double epsilon, double stepUlps) const
+{
+    double extent = std::max({std::abs(minr), std::abs(maxr), std::abs(mini), std::abs(maxi), 1.0});
+    double ulp = extent * epsilon;
+
+    return std::min(stepr, stepi) >= stepUlps * ulp;
+}
+
+bool ZoomMandelbrotCalculator::isFloatPrecisionSufficient() const
+{
+    // The margin absorbs the rounding error the iteration accumulates near the
+    // boundary: with 64 ulps (a step of about 1e-5 near |c| = 1) float and double
+    // renders differ on roughly 1% of the pixels.
+    constexpr double FLOAT_STEP_ULPS = 64.0;
+    return isPrecisionSufficient(std::numeric_limits<float>::epsilon(), FLOAT_STEP_ULPS);
+}
+
+bool ZoomMandelbrotCalculator::isDoublePrecisionSufficient() const
+{
+    // No accuracy margin here: the double-double kernels run about ten times
+    // slower, so double keeps the views it can still place. With 4 ulps a rounded
+    // coordinate is off by at most an eighth of a step; the boundary pixels that
+    // change between double and double-double at that depth change as much
+    // between two views a step apart.
+    constexpr double DOUBLE_STEP_ULPS = 4.0;
+    return isPrecisionSufficient(std::numeric_limits<double>::epsilon(), DOUBLE_STEP_ULPS);
+}
+
+double ZoomMandelbrotCalculator::periodicityEpsilon() const
+{
+    if (!periodicityCheck)
+        return 0.0;
+
+    // A fraction of a pixel: an orbit that comes back this close is taken as
+    // captured by an attracting cycle
+    constexpr double PERIOD_EPS_PIXELS = 1.0 / 64.0;
+    return std::min(stepr, stepi) * PERIOD_EPS_PIXELS;
+}
+
+double ZoomMandelbrotCalculator::derivativeEpsilon() const
+{
+    if (!derivativeCheck)
+        return 0.0;
+
+    // Unlike the periodicity distance it does not depend on the view, the
+    // derivative is a ratio. |dz/dz0| = 1e-6 leaves a wide margin: even 1e-2
+    // turned no exterior pixel black on minibrot and filament test views.
+    constexpr double DERIVATIVE_EPS = 1e-12;
+    return DERIVATIVE_EPS;
 }
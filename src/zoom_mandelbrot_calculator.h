@@ -9,6 +9,9 @@ public:
 
     void updateBounds(double cre, double cim, double diam) override;
     void updateBoundsExplicit(double minR, double minI, double maxR, double maxI) override;
+    void updateBoundsHP(const HighPrecision &cre, const HighPrecision &cim, FloatExp diam) override;
+    void updateBoundsRelative(const HighPrecision &refR, const HighPrecision &refI,
+                              FloatExp minR, FloatExp minI, FloatExp maxR, FloatExp maxI) override;
 
     int getWidth() const override { return width; }
     int getHeight() const override { return height; }
@@ -20,10 +23,34 @@ public:
     double getMinI() const override { return mini; }
     double getStepR() const override { return stepr; }
     double getStepI() const override { return stepi; }
+    HighPrecision getCreHP() const override;
+    HighPrecision getCimHP() const override;
+    FloatExp getDiamFE() const override { return deepDiam; }
+    FloatExp getStepRFE() const override { return deepStepR; }
+    FloatExp getStepIFE() const override { return deepStepI; }
+
+    // Plain double coordinates stop resolving pixels around here
+    FloatExp getMinDiam() const override { return 1e-15; }
 
     void setSpeedMode(bool mode) override { speedMode = mode; }
     bool getSpeedMode() const override { return speedMode; }
 
+    void setMaxIter(int newMaxIter) override { maxIter = newMaxIter; }
+    int getMaxIter() const override { return maxIter; }
+
+    void setPeriodicityCheck(bool enabled) override { periodicityCheck = enabled; }
+    bool getPeriodicityCheck() const override { return periodicityCheck; }
+
+    void setDerivativeCheck(bool enabled) override { derivativeCheck = enabled; }
+    bool getDerivativeCheck() const override { return derivativeCheck; }
+
+    // True when single precision still separates neighbouring pixels of this view
+    // with a safety margin, i.e. a float kernel renders it like a double one would
+    bool isFloatPrecisionSufficient() const;
+    // True while double coordinates still place every pixel within a fraction of a
+    // step, below this the view needs double-double coordinates
+    bool isDoublePrecisionSufficient() const;
+
 protected:
     int width;
     int height;
@@ -32,5 +59,34 @@ protected:
     double minr, mini, maxr, maxi;
     double stepr, stepi;
 
+    // High-precision reference point of the view and the view's top-left corner
+    // relative to it: pixel (x, y) is c = ref + (dminr + x * stepr, dmini + y * stepi).
+    // The double fields above are the same view rounded to double.
+    HighPrecision refr, refi;
+    double dminr, dmini;
+    // Same offsets, steps and diameter with the exponent range of FloatExp. The
+    // doubles underflow on views deeper than about 1e-300, engines going further
+    // read these.
+    FloatExp deepMinR, deepMinI;
+    FloatExp deepStepR, deepStepI;
+    FloatExp deepDiam;
+
+    int maxIter;
     bool speedMode;
+    bool periodicityCheck;
+    bool derivativeCheck;
+
+    // Distance under which an orbit point counts as a repeat of the saved one.
+    // Tied to the pixel step, 0 when periodicity checking is disabled.
+    double periodicityEpsilon() const;
+    // Squared |dz/dz0| under which an orbit counts as attracted, 0 when derivative
+    // checking is disabled
+    double derivativeEpsilon() const;
+
+    // Sets the FloatExp bounds from the double ones
+    void updateDeepBounds();
+
+    // Pixel step against the resolution of a format of the given epsilon: true
+    // while neighbouring pixels are at least stepUlps ulps apart
+    bool isPrecisionSufficient(double epsilon, double stepUlps) const;
 };
@@ -1,5 +1,6 @@
 #include "zoom_point_chooser.h"
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 
 ZoomPointChooser::ZoomPointChooser(int w, int h)
@@ -38,9 +39,9 @@ void ZoomPointChooser::getIterationRange(const std::vector<int> &data, int maxIt
     }
 }
 
-int ZoomPointChooser::calculateDiversityScore(const std::vector<int> &data, int maxIter,
-                                              int centerX, int centerY,
-                                              int rectWidth, int rectHeight)
+int64_t ZoomPointChooser::calculateDiversityScore(const std::vector<int> &data, int maxIter,
+                                                  int centerX, int centerY,
+                                                  int rectWidth, int rectHeight)
 {
     int x = centerX - rectWidth / 2;
     int y = centerY - rectHeight / 2;
@@ -51,8 +52,8 @@ int ZoomPointChooser::calculateDiversityScore(const std::vector<int> &data, int
     // Score is based on:
     // 1. Range of iterations (diversity)
     // 2. Maximum iteration value (we want high complexity)
-    // Combined score: range * maxIter
-    int range = maxIter_ - minIter;
+    // Combined score: range * maxIter, in 64 bits: budgets past 46341 overflow int
+    int64_t range = maxIter_ - minIter;
     return range * maxIter_;
 }
 
@@ -60,7 +61,7 @@ bool ZoomPointChooser::findInterestingPoint(const std::vector<int> &data, int ma
                                             int &outX, int &outY,
                                             int zoomRectWidth, int zoomRectHeight)
 {
-    // First pass: find the maximum non-MAX_ITER value in the entire view
+    // First pass: find the maximum escaped (below maxIter) value in the entire view
     int maxIterFound = 0;
     for (int y = 0; y < height; ++y)
     {
@@ -138,14 +139,14 @@ bool ZoomPointChooser::findInterestingPoint(const std::vector<int> &data, int ma
     struct Candidate
     {
         int x, y;
-        int score;
+        int64_t score;
     };
     std::vector<Candidate> candidates;
     
     for (const auto& point : sampledPoints)
     {
-        int score = calculateDiversityScore(data, maxIter, point.x, point.y,
-                                            zoomRectWidth, zoomRectHeight);
+        int64_t score = calculateDiversityScore(data, maxIter, point.x, point.y,
+                                                zoomRectWidth, zoomRectHeight);
         if (score > 0)
         {
             candidates.push_back({point.x, point.y, score});
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 class ZoomPointChooser
@@ -23,7 +24,7 @@ private:
                            int &outMin, int &outMax);
 
     // Calculate diversity score for a potential zoom point
-    int calculateDiversityScore(const std::vector<int> &data, int maxIter,
-                                int centerX, int centerY,
-                                int rectWidth, int rectHeight);
+    int64_t calculateDiversityScore(const std::vector<int> &data, int maxIter,
+                                    int centerX, int centerY,
+                                    int rectWidth, int rectHeight);
 };